@@ -0,0 +1,75 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+
+import math
+# resolution
+resx = 100.0
+# plasma length
+L = 2.0*math.pi
+
+Main(
+    geometry = "1Dcartesian",
+    interpolation_order = 2,
+    
+    cell_length = [L/resx],
+    grid_length  = [3.0*L],
+    
+    number_of_patches = [ 4 ],
+    
+    # timestep at the CFL limit
+    timestep = 0.95 * L/resx,
+    simulation_time = 10.0 * math.pi,
+    
+    EM_boundary_conditions = [ ['silver-muller'] ],
+    
+)
+
+# Coulomb explosion of ions pushed every 4 iterations
+Species(
+	name = "charges",
+	position_initialization = "regular",
+	momentum_initialization = "cold",
+	particles_per_cell = 16,
+	mass = 1836.0,
+	charge = 1.0,
+	number_density = trapezoidal(1., xvacuum=L, xplateau=L),
+	boundary_conditions = [
+		["stop", "stop"],
+	],
+	push_every = 4,
+)
+
+# Same ions, pushed at every iteration in the same fields
+Species(
+	name = "charges_ref",
+	position_initialization = "regular",
+	momentum_initialization = "cold",
+	particles_per_cell = 16,
+	mass = 1836.0,
+	charge = 1.0,
+	number_density = trapezoidal(1., xvacuum=L, xplateau=L),
+	boundary_conditions = [
+		["stop", "stop"],
+	],
+	is_test = True,
+)
+
+DiagFields(
+	every = 40,
+	fields = ['Ex','Rho_charges']
+)
+
+DiagScalar(
+	every = 4
+)
+
+for species in ["charges", "charges_ref"]:
+	DiagParticleBinning(
+		deposited_quantity = "weight",
+		every = 40,
+		species = [species],
+		axes = [
+			["x", 0., 3.0*L, 60],
+		]
+	)
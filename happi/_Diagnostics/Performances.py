@@ -179,10 +179,10 @@ class Performances(Diagnostic):
 		self._data_transform = data_transform
 		self._cumulative = cumulative
 		
-		# In case of "vecto" quantity, get the species
+		# In case of "vecto" or "timer_dynamics" quantity, get the species
 		if species is not None:
-			if self.operation != "vecto":
-				raise Exception("Argument `species` only valid with quantity 'vecto'")
+			if self.operation not in ["vecto", "timer_dynamics"]:
+				raise Exception("Argument `species` only valid with quantities 'vecto' or 'timer_dynamics'")
 			self._species = str(species)
 		
 		# 2 - Manage timesteps
@@ -295,21 +295,33 @@ class Performances(Diagnostic):
 		
 		# Calculate the operation
 		# First patch performance information
-		if  self.operation in ["vecto", "mpi_rank"]:
+		if  self.operation in ["vecto", "timer_dynamics", "mpi_rank"]:
 			if self._mode != "raw":
-				print("With quantities `vecto` or `mpi_rank`, only mode `raw` is supported")
+				print("With quantities `vecto`, `timer_dynamics` or `mpi_rank`, only mode `raw` is supported")
 				return []
 			
 			if "patches" not in self._h5items[index].keys():
 				print("No patches group in timestep {}".format(str(t)))
 				return []
 
-			if self.operation=="vecto":
+			if self.operation in ["vecto", "timer_dynamics"]:
 
 				if self._species not in self._h5items[index]["patches"].keys():
 					print("Requested species {} does not have a group".format(self._species))
 					return []
-				patches_buffer = self._np.array(self._h5items[index]["patches"][self._species]["vecto"])
+				if self.operation not in self._h5items[index]["patches"][self._species].keys():
+					print("Requested {} is not available for species {}".format(self.operation, self._species))
+					return []
+				patches_buffer = self._np.array(self._h5items[index]["patches"][self._species][self.operation])
+				# If not cumulative, make the difference with the previous time
+				if not self._cumulative and self.operation=="timer_dynamics" and index > 0:
+					previous = self._h5items[index-1]["patches"]
+					prev_buffer = self._np.array(previous[self._species][self.operation])
+					# The timers of a patch restart from zero when it moves to another MPI process
+					reset = patches_buffer < prev_buffer
+					if "mpi_rank" in previous and "mpi_rank" in self._h5items[index]["patches"]:
+						reset |= self._np.array(self._h5items[index]["patches"]["mpi_rank"]) != self._np.array(previous["mpi_rank"])
+					patches_buffer = self._np.where(reset, patches_buffer, patches_buffer - prev_buffer)
 
 			elif self.operation=="mpi_rank":
 
@@ -49,7 +49,9 @@ Checkpoint::Checkpoint( Params &params, SmileiMPI *smpi ) :
     keep_n_dumps_max( 10000 ),
     dump_deflate( 0 ),
     dump_request( smpi->getSize() ),
-    file_grouping( 0 )
+    file_grouping( 0 ),
+    restart_file_grouping_( 0 ),
+    restart_file_grouping_known_( true )
 {
 
     if( PyTools::nComponents( "Checkpoints" ) > 0 ) {
@@ -251,6 +253,7 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, Region &region, unsigned int
     f.attr( "dump_number", dump_number );
 
     f.vect( "patch_count", smpi->patch_count );
+    f.attr( "file_grouping", file_grouping );
 
     // Write diags scalar data
     DiagnosticScalar *scalars = static_cast<DiagnosticScalar *>( vecPatches.globalDiags[0] );
@@ -320,6 +323,7 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, Region &region, unsigned int
             ostringstream n( "" );
             n<< "latest_ID_" << vecPatches( 0 )->vecSpecies[track->speciesId_]->name_;
             f.attr( n.str(), track->latest_Id, H5T_NATIVE_UINT64 );
+            f.attr( "selection_done_" + vecPatches( 0 )->vecSpecies[track->speciesId_]->name_, ( int )track->selection_done_ );
         }
     }
 
@@ -570,9 +574,34 @@ void Checkpoint::readPatchDistribution( SmileiMPI *smpi, SimWindow *simWin )
         WARNING( "                while running version is " << string( __VERSION ) );
     }
 
-    vector<int> patch_count( smpi->getSize() );
+    vector<int> patch_count( f.vectSize( "patch_count" ) );
     f.vect( "patch_count", patch_count );
-    smpi->patch_count = patch_count;
+
+    if( patch_count.size() == ( unsigned int )smpi->getSize() ) {
+        smpi->patch_count = patch_count;
+    } else {
+        // Elastic restart : the patches are distributed evenly on the new MPI processes,
+        // and each process reads its patches from the files of the previous run
+        restart_patch_count_ = patch_count;
+        restart_file_grouping_known_ = f.hasAttr( "file_grouping" );
+        if( restart_file_grouping_known_ ) {
+            f.attr( "file_grouping", restart_file_grouping_ );
+        } else {
+            WARNING( "The checkpoints do not record their file_grouping (older version): the files of the previous run are searched by name" );
+        }
+        int npatches = 0;
+        for( unsigned int rk=0 ; rk<patch_count.size() ; rk++ ) {
+            npatches += patch_count[rk];
+        }
+        if( npatches < smpi->getSize() ) {
+            ERROR( "Cannot restart " << npatches << " patches on " << smpi->getSize() << " MPI processes" );
+        }
+        MESSAGE( 1, "Restarting on " << smpi->getSize() << " MPI processes a simulation dumped by " << patch_count.size() << " MPI processes" );
+        smpi->patch_count.resize( smpi->getSize() );
+        for( int rk=0 ; rk<smpi->getSize() ; rk++ ) {
+            smpi->patch_count[rk] = npatches / smpi->getSize() + ( rk < npatches % smpi->getSize() ? 1 : 0 );
+        }
+    }
 
     smpi->patch_refHindexes.resize( smpi->patch_count.size(), 0 );
     smpi->patch_refHindexes[0] = 0;
@@ -599,17 +628,36 @@ void Checkpoint::restartAll( VectorPatch &vecPatches, Region &region, SmileiMPI
         f.attr( "Energy_time_zero",  scalars->Energy_time_zero );
         f.attr( "EnergyUsedForNorm", scalars->EnergyUsedForNorm );
     }
+    // In an elastic restart, the processes which did not exist in the previous run
+    // only read the header of the file of rank 0
+    bool own_file = restart_patch_count_.size()==0 || smpi->getRank() < ( int )restart_patch_count_.size();
+
     // Poynting scalars
     unsigned int k=0;
     for( unsigned int j=0; j<2; j++ ) { //directions (xmin/xmax, ymin/ymax, zmin/zmax)
         for( unsigned int i=0; i<params.nDim_field; i++ ) { //axis 0=x, 1=y, 2=z
             string poy_name = Tools::merge( "Poy", Tools::xyz[i], j==0?"min":"max" );
-            if( f.hasAttr( poy_name ) ) {
+            if( own_file && f.hasAttr( poy_name ) ) {
                 f.attr( poy_name, vecPatches( 0 )->EMfields->poynting[j][i] );
             }
             k++;
         }
     }
+    // Restart on fewer processes: the Poynting sums of the previous ranks which no longer
+    // exist are added to those of rank ( old_rank % number of processes )
+    for( int old_rank = smpi->getRank() + smpi->getSize(); old_rank < ( int )restart_patch_count_.size(); old_rank += smpi->getSize() ) {
+        H5Read g( restartFileOfRank( old_rank ) );
+        for( unsigned int j=0; j<2; j++ ) {
+            for( unsigned int i=0; i<params.nDim_field; i++ ) {
+                string poy_name = Tools::merge( "Poy", Tools::xyz[i], j==0?"min":"max" );
+                if( g.hasAttr( poy_name ) ) {
+                    double poy = 0.;
+                    g.attr( poy_name, poy );
+                    vecPatches( 0 )->EMfields->poynting[j][i] += poy;
+                }
+            }
+        }
+    }
 
     // Read the diags screen data
     if( smpi->isMaster() ) {
@@ -631,18 +679,50 @@ void Checkpoint::restartAll( VectorPatch &vecPatches, Region &region, SmileiMPI
     }
 
     // Read all the patch data
-    for( unsigned int ipatch=0 ; ipatch<vecPatches.size(); ipatch++ ) {
+    if( restart_patch_count_.size() == 0 ) {
+        for( unsigned int ipatch=0 ; ipatch<vecPatches.size(); ipatch++ ) {
 
-        ostringstream patch_name( "" );
-        patch_name << setfill( '0' ) << setw( 6 ) << vecPatches( ipatch )->Hindex();
-        string patchName = Tools::merge( "patch-", patch_name.str() );
-        H5Read g = f.group( patchName );
+            ostringstream patch_name( "" );
+            patch_name << setfill( '0' ) << setw( 6 ) << vecPatches( ipatch )->Hindex();
+            string patchName = Tools::merge( "patch-", patch_name.str() );
+            H5Read g = f.group( patchName );
 
-        restartPatch( vecPatches( ipatch ), params, g );
+            restartPatch( vecPatches( ipatch ), params, g );
 
-        // Random number generator state
-        g.attr( "xorshift32_state", vecPatches( ipatch )->rand_->xorshift32_state );
+            // Random number generator state
+            g.attr( "xorshift32_state", vecPatches( ipatch )->rand_->xorshift32_state );
 
+        }
+    } else {
+        // Elastic restart : patches are read from the file of the rank which owned them
+        int old_rank = 0;
+        unsigned int old_last_hindex = restart_patch_count_[0];
+        H5Read *fp = NULL;
+        for( unsigned int ipatch=0 ; ipatch<vecPatches.size(); ipatch++ ) {
+            unsigned int hindex = vecPatches( ipatch )->Hindex();
+            bool new_file = ( fp == NULL );
+            while( hindex >= old_last_hindex ) {
+                old_rank++;
+                old_last_hindex += restart_patch_count_[old_rank];
+                new_file = true;
+            }
+            if( new_file ) {
+                delete fp;
+                fp = new H5Read( restartFileOfRank( old_rank ) );
+            }
+
+            ostringstream patch_name( "" );
+            patch_name << setfill( '0' ) << setw( 6 ) << hindex;
+            string patchName = Tools::merge( "patch-", patch_name.str() );
+            H5Read g = fp->group( patchName );
+
+            restartPatch( vecPatches( ipatch ), params, g );
+
+            // Random number generator state
+            g.attr( "xorshift32_state", vecPatches( ipatch )->rand_->xorshift32_state );
+
+        }
+        delete fp;
     }
 
     if (params.multiple_decomposition) {
@@ -658,11 +738,27 @@ void Checkpoint::restartAll( VectorPatch &vecPatches, Region &region, SmileiMPI
         if( DiagnosticTrack *track = dynamic_cast<DiagnosticTrack *>( vecPatches.localDiags[idiag] ) ) {
             ostringstream n( "" );
             n<< "latest_ID_" << vecPatches( 0 )->vecSpecies[track->speciesId_]->name_;
-            if( f.hasAttr( n.str() ) ) {
+            if( !own_file ) {
+                // New processes start their own range of IDs, as DiagnosticTrack::init does not set it after a restart
+                track->latest_Id = smpi->getRank() * 4294967296; // 2^32
+            } else if( f.hasAttr( n.str() ) ) {
                 f.attr( n.str(), track->latest_Id, H5T_NATIVE_UINT64 );
             } else {
                 track->IDs_done=false;
             }
+            // Whether the filter was already applied (same on all ranks)
+            string selection_name = "selection_done_" + vecPatches( 0 )->vecSpecies[track->speciesId_]->name_;
+            if( f.hasAttr( selection_name ) ) {
+                int selection_done = 0;
+                f.attr( selection_name, selection_done );
+                track->selection_done_ = selection_done;
+            } else {
+                // Older dumps: the selection was done if any rank gave IDs (latest_Id starts at rank*2^32)
+                int ids_given = own_file && track->latest_Id > ( uint64_t )smpi->getRank() * 4294967296;
+                int any_ids_given = 0;
+                MPI_Allreduce( &ids_given, &any_ids_given, 1, MPI_INT, MPI_LOR, smpi->world() );
+                track->selection_done_ = any_ids_given;
+            }
         }
     }
 
@@ -671,6 +767,10 @@ void Checkpoint::restartAll( VectorPatch &vecPatches, Region &region, SmileiMPI
 
 void Checkpoint::readRegionDistribution( Region &region )
 {
+    if( restart_patch_count_.size() > 0 ) {
+        ERROR( "Restarting on a different number of MPI processes is not available with the multiple decomposition" );
+    }
+
     int read_hindex( -1 );
 
     hid_t file = H5Fopen(restart_file.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
@@ -697,6 +797,44 @@ void Checkpoint::readRegionDistribution( Region &region )
 }
 
 
+string Checkpoint::restartFileOfRank( int rank )
+{
+    // restart_file is <restart_dir>/checkpoints/[group/]dump-<number>-<rank>.h5
+    string checkpoints_dir = string( "checkpoints" ) + PATH_SEPARATOR;
+    string dir = restart_file.substr( 0, restart_file.rfind( checkpoints_dir ) ) + checkpoints_dir;
+    string name = restart_file.substr( restart_file.rfind( PATH_SEPARATOR )+1 );
+
+    unsigned int old_size = restart_patch_count_.size();
+    if( restart_file_grouping_known_ ) {
+        return restartFileOfRank( rank, dir, name, restart_file_grouping_, old_size );
+    }
+
+    // Dumps without the file_grouping attribute: old per-rank layout, possibly grouped in
+    // sub-directories of unknown size. File names are unique, so the first existing path is the right one.
+    for( unsigned int grouping=0 ; grouping<=old_size ; grouping++ ) {
+        string file_name = restartFileOfRank( rank, dir, name, grouping, old_size );
+        if( Tools::fileExists( file_name ) ) {
+            return file_name;
+        }
+    }
+    ERROR( "Cannot find the checkpoint file of rank " << rank << " of the previous run in " << dir );
+    return "";
+}
+
+
+string Checkpoint::restartFileOfRank( int rank, string dir, string name, unsigned int grouping, unsigned int old_size )
+{
+    ostringstream file_name( "" );
+    file_name << dir;
+    if( grouping > 0 ) {
+        file_name << setfill( '0' ) << setw( int( 1+log10( old_size/grouping+1 ) ) ) << rank/grouping << PATH_SEPARATOR;
+    }
+    // name.substr( 0, 11 ) is "dump-<number>-"
+    file_name << name.substr( 0, 11 ) << setfill( '0' ) << setw( 10 ) << rank << ".h5";
+    return file_name.str();
+}
+
+
 void Checkpoint::restartPatch( Patch *patch, Params &params, H5Read &g )
 {
     ElectroMagn * EMfields = patch->EMfields;
@@ -980,6 +1118,7 @@ void Checkpoint::dumpMovingWindow( H5Write &f, SimWindow *simWin )
 {
     f.attr( "x_moved", simWin->getXmoved() );
     f.attr( "n_moved", simWin->getNmoved() );
+    f.attr( "deferred_columns", simWin->getNumberOfDeferredColumns() );
 }
 void Checkpoint::restartMovingWindow( H5Read &f, SimWindow *simWin )
 {
@@ -992,4 +1131,8 @@ void Checkpoint::restartMovingWindow( H5Read &f, SimWindow *simWin )
     f.attr( "n_moved", n_moved );
     simWin->setNmoved( n_moved );
 
+    unsigned int deferred_columns=0;
+    f.attr( "deferred_columns", deferred_columns );
+    simWin->setNumberOfDeferredColumns( deferred_columns );
+
 }
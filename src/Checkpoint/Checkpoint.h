@@ -146,6 +146,21 @@ private:
     //! restart file
     std::string restart_file;
     
+    //! Patch distribution of the previous run, if it had a different number of MPI processes (empty otherwise)
+    std::vector<int> restart_patch_count_;
+    
+    //! file_grouping of the previous run
+    unsigned int restart_file_grouping_;
+    
+    //! Whether the dumps of the previous run record their file_grouping
+    bool restart_file_grouping_known_;
+    
+    //! Name of the restart file written by the MPI process rank in the previous run
+    std::string restartFileOfRank( int rank );
+    
+    //! Name of the restart file of a rank, for a given file_grouping of the previous run
+    std::string restartFileOfRank( int rank, std::string dir, std::string name, unsigned int grouping, unsigned int old_size );
+    
 };
 
 #endif /* CHECKPOINT_H_ */
@@ -40,6 +40,15 @@ public :
     //! Runs the diag for a given patch for global diags.
     virtual void run( Patch *patch, int itime, SimWindow *simWindow ) {};
     
+    //! Updates the list of local patches where a global diag has something to do. Only by MPI master.
+    virtual void updatePatchIndex( VectorPatch &vecPatches, int itime ) {};
+    
+    //! Local indices of the patches where a global diag has something to do (NULL means all patches)
+    virtual std::vector<unsigned int> *patchIndex()
+    {
+        return NULL;
+    };
+    
     //! Runs the diag for all patches for local diags.
     virtual void run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime, SimWindow *simWindow, Timers &timers ) {};
     
@@ -42,6 +42,12 @@ DiagnosticPerformances::DiagnosticPerformances( Params &params, SmileiMPI *smpi
     // Get patch information flag
     PyTools::extract( "patch_information", patch_information, "DiagPerformances"  );
     
+    // Get patch timers flag, which needs the patch information
+    PyTools::extract( "patch_timers", patch_timers, "DiagPerformances"  );
+    if( patch_timers && ! patch_information ) {
+        ERROR( errorPrefix << ": `patch_timers` requires `patch_information`" );
+    }
+    
     // Output info on diagnostics
     if( smpi->isMaster() ) {
         MESSAGE( 1, "Created performances diagnostic" );
@@ -127,6 +133,9 @@ void DiagnosticPerformances::init( Params &params, SmileiMPI *smpi, VectorPatch
 {
     // create the file
     openFile( params, smpi );
+    
+    // Activate the timing of species dynamics in each patch
+    vecPatches.patch_timers_ = patch_timers;
 }
 
 
@@ -284,6 +293,17 @@ void DiagnosticPerformances::run( SmileiMPI *smpi, VectorPatch &vecPatches, int
                     // Write patch vectorization status  to file
                     species_group.vect( "vecto", buffer[0], size, H5T_NATIVE_UINT, offset, npoints );
                 }
+                
+                // Time spent in the dynamics
+                if( patch_timers ) {
+                    // Gather patch timers in a buffer
+                    vector<double> timer_buffer( number_of_patches );
+                    for( unsigned int ipatch=0; ipatch < number_of_patches; ipatch++ ) {
+                        timer_buffer[ipatch] = vecPatches( ipatch )->vecSpecies[ispecies]->timer_dynamics_;
+                    }
+                    // Write patch timers to file
+                    species_group.vect( "timer_dynamics", timer_buffer[0], size, H5T_NATIVE_DOUBLE, offset, npoints );
+                }
             }
             
             // Write MPI process the owns the patch
@@ -65,6 +65,9 @@ private :
     //! Whether to output patch information
     bool patch_information;
     
+    //! Whether to measure and output the time spent in the dynamics of each species in each patch
+    bool patch_timers;
+    
     //! Number of cells per patch
     unsigned int ncells_per_patch;
     
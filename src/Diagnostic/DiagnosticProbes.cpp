@@ -348,6 +348,31 @@ DiagnosticProbes::DiagnosticProbes( Params &params, SmileiMPI *smpi, VectorPatch
     for( unsigned int k=0; k<nDim_particle; k++ ) {
         patch_size[k] = params.n_space[k]*params.cell_length[k];
     }
+    cell_length = params.cell_length;
+    
+    // Axis-aligned probes in cartesian geometry with the standard 2nd order interpolation
+    // may resample the fields with pre-computed separable stencils
+    use_grid_stencil = geometry != "AMcylindrical"
+                       && params.interpolation_order == 2
+                       && params.interpolator_ == "momentum-conserving";
+    axis_dimension.resize( 0 );
+    vector<bool> dimension_used( nDim_particle, false );
+    for( unsigned int i=0; i<dimProbe && use_grid_stencil; i++ ) {
+        unsigned int n_nonzero = 0;
+        for( unsigned int j=0; j<nDim_particle; j++ ) {
+            if( axes[j+nDim_particle*i] != 0. ) {
+                n_nonzero++;
+                if( n_nonzero == 1 ) {
+                    axis_dimension.push_back( j );
+                }
+            }
+        }
+        if( n_nonzero != 1 || dimension_used[axis_dimension.back()] ) {
+            use_grid_stencil = false;
+        } else {
+            dimension_used[axis_dimension.back()] = true;
+        }
+    }
 
     // Create filename
     ostringstream mystream( "" );
@@ -467,6 +492,7 @@ void DiagnosticProbes::createPoints( SmileiMPI *smpi, VectorPatch &vecPatches, d
     vector<double> point( nDim_particle ), mins( nDim_particle ), maxs( nDim_particle ); //warning, works only if nDim_particle >= nDim_field
     vector<double> patchMin( nDim_particle ), patchMax( nDim_particle );
     vector<unsigned int> minI( nDim_particle ), maxI( nDim_particle ), nI( nDim_particle );
+    vector<unsigned int> axisI( nDim_particle ), minKept( nDim_particle ), maxKept( nDim_particle );
 
     // Loop patches to create particles
     for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
@@ -549,11 +575,16 @@ void DiagnosticProbes::createPoints( SmileiMPI *smpi, VectorPatch &vecPatches, d
         }
         // Loop useful probe points
         ipart_local=0;
+        for( i=0; i<dimProbe; i++ ) {
+            minKept[i] = numeric_limits<unsigned int>::max();
+            maxKept[i] = 0;
+        }
         for( unsigned int ip=0; ip<ntot; ip++ ) {
             // Find the coordinates of this point in the global probe array
             IP = ip;
             for( i=0; i<dimProbe; i++ ) {
-                point[i] = ( ( double )( IP % nI[i] + minI[i] ) ) / ( ( double )( vecNumber[i]-1 ) );
+                axisI[i] = IP % nI[i];
+                point[i] = ( ( double )( axisI[i] + minI[i] ) ) / ( ( double )( vecNumber[i]-1 ) );
                 IP /= nI[i];
             }
             for( i=dimProbe; i<nDim_particle; i++ ) {
@@ -586,6 +617,10 @@ void DiagnosticProbes::createPoints( SmileiMPI *smpi, VectorPatch &vecPatches, d
                 for( iDim=0; iDim<nDim_particle; iDim++ ) {
                     particles->position( iDim, ipart_local ) = point[iDim];
                 }
+                for( i=0; i<dimProbe; i++ ) {
+                    minKept[i] = min( minKept[i], axisI[i] );
+                    maxKept[i] = max( maxKept[i], axisI[i] );
+                }
                 ipart_local++;
             }
         }
@@ -594,6 +629,27 @@ void DiagnosticProbes::createPoints( SmileiMPI *smpi, VectorPatch &vecPatches, d
         particles->resize( ipart_local, nDim_particle, false );
         particles->shrinkToFit();
 
+        // For axis-aligned probes, the points kept in this patch form a box in the probe grid:
+        // pre-compute their interpolation stencils
+        ProbeParticles *probe = vecPatches( ipatch )->probes[probe_n];
+        delete probe->stencil;
+        probe->stencil = NULL;
+        if( use_grid_stencil && ipart_local > 0 ) {
+            vector<unsigned int> axis_number( dimProbe );
+            unsigned int nbox = 1;
+            for( i=0; i<dimProbe; i++ ) {
+                axis_number[i] = maxKept[i] - minKept[i] + 1;
+                nbox *= axis_number[i];
+            }
+            if( nbox == ipart_local ) {
+                vector<int> domain_begin( nDim_field );
+                for( i=0; i<nDim_field; i++ ) {
+                    domain_begin[i] = vecPatches( ipatch )->getCellStartingGlobalIndex( i );
+                }
+                probe->stencil = new ProbeGridStencil( *particles, axis_dimension, axis_number, domain_begin, cell_length );
+            }
+        }
+
         // Add the local offset
         offset_in_MPI[ipatch] = nPart_MPI;
         nPart_MPI += ipart_local;
@@ -710,28 +766,41 @@ void DiagnosticProbes::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
         // Interpolate all usual fields on probe ("fake") particles of current patch
         unsigned int iPart_MPI = offset_in_MPI[ipatch];
         unsigned int maxPart_MPI = offset_in_MPI[ipatch] + npart;
-        smpi->dynamics_resize( ithread, nDim_particle, npart, false );
-        for( unsigned int ipart=0; ipart<npart; ipart++ ) {
-            int iparticle( ipart ); // Compatibility
-            int false_idx( 0 );   // Use in classical interp for now, not for probes
-            patch->probesInterp->fieldsAndCurrents(
-                patch->EMfields,
-                patch->probes[probe_n]->particles, smpi,
-                &iparticle, &false_idx, ithread,
-                &Jloc_fields, &Rloc_fields
-            );
-            //! here we fill the probe data!!!
-            ( *probesArray )( fieldlocation[0], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+0*npart];
-            ( *probesArray )( fieldlocation[1], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+1*npart];
-            ( *probesArray )( fieldlocation[2], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+2*npart];
-            ( *probesArray )( fieldlocation[3], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+0*npart];
-            ( *probesArray )( fieldlocation[4], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+1*npart];
-            ( *probesArray )( fieldlocation[5], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+2*npart];
-            ( *probesArray )( fieldlocation[6], iPart_MPI )=Jloc_fields.x;
-            ( *probesArray )( fieldlocation[7], iPart_MPI )=Jloc_fields.y;
-            ( *probesArray )( fieldlocation[8], iPart_MPI )=Jloc_fields.z;
-            ( *probesArray )( fieldlocation[9], iPart_MPI )=Rloc_fields;
-            iPart_MPI++;
+        ProbeGridStencil *stencil = patch->probes[probe_n]->stencil;
+        if( stencil ) {
+            // Axis-aligned probe: resample directly from the field arrays
+            ElectroMagn *EM = patch->EMfields;
+            Field *fields[10] = { EM->Ex_, EM->Ey_, EM->Ez_, EM->Bx_m, EM->By_m, EM->Bz_m, EM->Jx_, EM->Jy_, EM->Jz_, EM->rho_ };
+            for( unsigned int k=0; k<10; k++ ) {
+                // Skip fields that go to the garbage buffer
+                if( fieldlocation[k] != nFields ) {
+                    stencil->interpolate( fields[k], &( ( *probesArray )( fieldlocation[k], iPart_MPI ) ) );
+                }
+            }
+        } else {
+            smpi->dynamics_resize( ithread, nDim_particle, npart, false );
+            for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+                int iparticle( ipart ); // Compatibility
+                int false_idx( 0 );   // Use in classical interp for now, not for probes
+                patch->probesInterp->fieldsAndCurrents(
+                    patch->EMfields,
+                    patch->probes[probe_n]->particles, smpi,
+                    &iparticle, &false_idx, ithread,
+                    &Jloc_fields, &Rloc_fields
+                );
+                //! here we fill the probe data!!!
+                ( *probesArray )( fieldlocation[0], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+0*npart];
+                ( *probesArray )( fieldlocation[1], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+1*npart];
+                ( *probesArray )( fieldlocation[2], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+2*npart];
+                ( *probesArray )( fieldlocation[3], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+0*npart];
+                ( *probesArray )( fieldlocation[4], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+1*npart];
+                ( *probesArray )( fieldlocation[5], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+2*npart];
+                ( *probesArray )( fieldlocation[6], iPart_MPI )=Jloc_fields.x;
+                ( *probesArray )( fieldlocation[7], iPart_MPI )=Jloc_fields.y;
+                ( *probesArray )( fieldlocation[8], iPart_MPI )=Jloc_fields.z;
+                ( *probesArray )( fieldlocation[9], iPart_MPI )=Rloc_fields;
+                iPart_MPI++;
+            }
         }
         
         // Calculate Poynting flux on each point if needed
@@ -788,12 +857,16 @@ void DiagnosticProbes::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
                     unsigned int iloc = species_field_location[ispec][j];
                     int istart( 0 ), iend( npart );
                     double *FieldLoc = &( ( *probesArray )( iloc, offset_in_MPI[ipatch] ) );
-                    patch->probesInterp->oneField(
-                        &patch->EMfields->allFields[start+ifield],
-                        patch->probes[probe_n]->particles,
-                        &istart, &iend,
-                        FieldLoc
-                    );
+                    if( stencil ) {
+                        stencil->interpolate( patch->EMfields->allFields[start+ifield], FieldLoc );
+                    } else {
+                        patch->probesInterp->oneField(
+                            &patch->EMfields->allFields[start+ifield],
+                            patch->probes[probe_n]->particles,
+                            &istart, &iend,
+                            FieldLoc
+                        );
+                    }
                 }
             }
         }
@@ -858,7 +931,7 @@ void DiagnosticProbes::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
 
 bool DiagnosticProbes::needsRhoJs( int itime )
 {
-    return hasRhoJs && timeSelection->theTimeIsNow( itime );
+    return hasRhoJs && ( time_integral || timeSelection->theTimeIsNow( itime ) );
 }
 
 // SUPPOSED TO BE EXECUTED ONLY BY MASTER MPI
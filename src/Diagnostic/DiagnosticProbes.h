@@ -4,6 +4,7 @@
 #include "Diagnostic.h"
 
 #include "Field2D.h"
+#include "ProbeGridStencil.h"
 
 
 class DiagnosticProbes : public Diagnostic
@@ -134,6 +135,15 @@ private:
     
     //! patch size
     std::vector<double> patch_size;
+    
+    //! cell size
+    std::vector<double> cell_length;
+    
+    //! True if the fields can be resampled with ProbeGridStencil (axis-aligned probe, 2nd order cartesian interpolation)
+    bool use_grid_stencil;
+    
+    //! For each probe axis, the field dimension it is oriented along (when use_grid_stencil)
+    std::vector<unsigned int> axis_dimension;
 };
 
 
@@ -141,15 +151,20 @@ private:
 class ProbeParticles
 {
 public :
-    ProbeParticles() {};
-    ProbeParticles( ProbeParticles *probe )
+    ProbeParticles() : stencil( NULL ) {};
+    ProbeParticles( ProbeParticles *probe ) : stencil( NULL )
     {
         offset_in_file=probe->offset_in_file;
     }
-    ~ProbeParticles() {};
+    ~ProbeParticles()
+    {
+        delete stencil;
+    };
     
     Particles particles;
     int offset_in_file;
+    //! Interpolation stencils of the points, when the probe is axis-aligned (NULL otherwise)
+    ProbeGridStencil *stencil;
     std::vector<std::vector<double> > integrated_data;
 };
 
@@ -3,6 +3,7 @@
 
 #include "DiagnosticScreen.h"
 #include "HistogramFactory.h"
+#include "VectorPatch.h"
 
 
 using namespace std;
@@ -152,6 +153,8 @@ DiagnosticScreen::DiagnosticScreen(
     
     data_sum.resize( output_size, 0. );
     
+    patch_index_iteration = -1;
+    
 } // END DiagnosticScreen::DiagnosticScreen
 
 
@@ -169,45 +172,63 @@ bool DiagnosticScreen::prepare( int itime )
 } // END prepare
 
 
-// run one screen diagnostic
-void DiagnosticScreen::run( Patch *patch, int itime, SimWindow *simWindow )
+// Verify that this patch is in a useful region for this diag
+bool DiagnosticScreen::intersects( Patch *patch )
 {
-
     unsigned int ndim = screen_point.size();
     
-    // Verify that this patch is in a useful region for this diag
     if( screen_type == 0 ) { // plane
         double distance_to_plane = 0.;
         for( unsigned int idim=0; idim<ndim; idim++ ) {
             distance_to_plane += ( patch->center_[idim] - screen_point[idim] ) * screen_unitvector[idim];
         }
-        if( abs( distance_to_plane ) > patch->radius ) {
-            return;
-        }
+        return abs( distance_to_plane ) <= patch->radius;
     } else if( screen_type == 1 ) { // sphere
         double distance_to_center = 0.;
         for( unsigned int idim=0; idim<ndim; idim++ ) {
             distance_to_center += pow( patch->center_[idim] - screen_point[idim], 2 );
         }
         distance_to_center = sqrt( distance_to_center );
-        if( abs( screen_vectornorm - distance_to_center ) > patch->radius ) {
-            return;
-        }
+        return abs( screen_vectornorm - distance_to_center ) <= patch->radius;
     } else if( screen_type == 2 ) { // cylinder
         double distance_to_axis = 0.;
         for( unsigned int idim=0; idim<ndim; idim++ ) {
-            distance_to_axis += pow( 
+            distance_to_axis += pow(
                  ( patch->center_[(idim+1)%ndim] - screen_point[(idim+1)%ndim] ) * screen_unitvector[(idim+2)%ndim]
                 -( patch->center_[(idim+2)%ndim] - screen_point[(idim+2)%ndim] ) * screen_unitvector[(idim+1)%ndim]
                 , 2 );
         }
         distance_to_axis = sqrt( distance_to_axis );
-        if( abs( screen_vectornorm - distance_to_axis ) > patch->radius ) {
-            return;
-        }
+        return abs( screen_vectornorm - distance_to_axis ) <= patch->radius;
     } else {
         ERROR( "unkown screen_type " << screen_type );
     }
+    return false;
+}
+
+
+// Update the list of patches crossed by the screen, when patches have moved (load balancing or moving window)
+void DiagnosticScreen::updatePatchIndex( VectorPatch &vecPatches, int itime )
+{
+    if( patch_index_iteration >= 0 && patch_index_iteration > ( int )vecPatches.lastIterationPatchesMoved ) {
+        return;
+    }
+    
+    patch_index.resize( 0 );
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+        if( intersects( vecPatches( ipatch ) ) ) {
+            patch_index.push_back( ipatch );
+        }
+    }
+    patch_index_iteration = itime;
+}
+
+
+// run one screen diagnostic, only for patches crossed by the screen
+void DiagnosticScreen::run( Patch *patch, int itime, SimWindow *simWindow )
+{
+
+    unsigned int ndim = screen_point.size();
     
     // Calculate the total number of particles in this patch and resize buffers
     unsigned int npart_total = 0;
@@ -224,6 +245,12 @@ void DiagnosticScreen::run( Patch *patch, int itime, SimWindow *simWindow )
         opposite[i] = false;
     }
     
+    // A particle moves by less than its timestep during one push: only particles closer than this
+    // to the screen may have crossed it. They are listed as candidates using their current
+    // position only, and the previous position is computed for these candidates only.
+    vector<double> side( npart_total );
+    vector<unsigned int> candidates;
+    
     // loop species & find crossing particles
     unsigned int nuseful = 0;
     unsigned int istart = 0;
@@ -233,72 +260,130 @@ void DiagnosticScreen::run( Patch *patch, int itime, SimWindow *simWindow )
         unsigned int npart = s->getNbrOfParticles();
         int *index = &int_buffer[istart];
         bool *opp = &opposite[istart];
-       
+        double *sd = &side[istart];
+        
         // Fill the int_buffer with -1 (not crossing screen) and 0 (crossing screen)
+        for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+            index[ipart] = -1;
+        }
+        candidates.resize( 0 );
+        
+        // Sub-cycled species only move at push iterations, with a timestep push_every*dt
+        if( ! s->isPushStep( itime ) ) {
+            istart += npart;
+            continue;
+        }
+        double species_dt = dt * s->push_every_;
+        double max_displacement = 1.01 * species_dt;
+        
         if( screen_type == 0 ) { // plane
+            // Signed distance to the plane
+            for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+                sd[ipart] = 0.;
+            }
+            for( unsigned int idim=0; idim<ndim; idim++ ) {
+                const double *const x = s->particles->Position[idim].data();
+                #pragma omp simd
+                for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+                    sd[ipart] += ( x[ipart] - screen_point[idim] ) * screen_unitvector[idim];
+                }
+            }
             for( unsigned int ipart=0; ipart<npart; ipart++ ) {
-                double side = 0.;
+                if( abs( sd[ipart] ) <= max_displacement ) {
+                    candidates.push_back( ipart );
+                }
+            }
+            for( unsigned int ic=0; ic<candidates.size(); ic++ ) {
+                unsigned int ipart = candidates[ic];
                 double side_old = 0.;
-                double dtg = dt / s->particles->LorentzFactor( ipart );
+                double dtg = species_dt / s->particles->LorentzFactor( ipart );
                 for( unsigned int idim=0; idim<ndim; idim++ ) {
-                    side += ( s->particles->Position[idim][ipart] - screen_point[idim] ) * screen_unitvector[idim];
                     side_old += ( s->particles->Position[idim][ipart] - dtg*( s->particles->Momentum[idim][ipart] ) - screen_point[idim] ) * screen_unitvector[idim];
                 }
-                if( side*side_old < 0. ) {
+                if( sd[ipart]*side_old < 0. ) {
                     index[ipart] = 0;
                     nuseful++;
-                    if( side < 0. ) {
+                    if( sd[ipart] < 0. ) {
                         opp[ipart] = true;
                     }
-                } else {
-                    index[ipart] = -1;
                 }
             }
         } else if( screen_type == 1 ) { // sphere
+            // Squared distance to the center
             for( unsigned int ipart=0; ipart<npart; ipart++ ) {
-                double side = 0.;
+                sd[ipart] = 0.;
+            }
+            for( unsigned int idim=0; idim<ndim; idim++ ) {
+                const double *const x = s->particles->Position[idim].data();
+                #pragma omp simd
+                for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+                    sd[ipart] += ( x[ipart] - screen_point[idim] ) * ( x[ipart] - screen_point[idim] );
+                }
+            }
+            double rmin = max( screen_vectornorm - max_displacement, 0. );
+            double rmax = screen_vectornorm + max_displacement;
+            for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+                if( sd[ipart] >= rmin*rmin && sd[ipart] <= rmax*rmax ) {
+                    candidates.push_back( ipart );
+                }
+            }
+            for( unsigned int ic=0; ic<candidates.size(); ic++ ) {
+                unsigned int ipart = candidates[ic];
                 double side_old = 0.;
-                double dtg = dt / s->particles->LorentzFactor( ipart );
+                double dtg = species_dt / s->particles->LorentzFactor( ipart );
                 for( unsigned int idim=0; idim<ndim; idim++ ) {
-                    side += pow( s->particles->Position[idim][ipart] - screen_point[idim], 2 );
                     side_old += pow( s->particles->Position[idim][ipart] - dtg*( s->particles->Momentum[idim][ipart] ) - screen_point[idim], 2 );
                 }
-                side     = screen_vectornorm-sqrt( side );
+                double side_new = screen_vectornorm-sqrt( sd[ipart] );
                 side_old = screen_vectornorm-sqrt( side_old );
-                if( side*side_old < 0. ) {
+                if( side_new*side_old < 0. ) {
                     index[ipart] = 0;
                     nuseful++;
-                    if( side > 0. ) {
+                    if( side_new > 0. ) {
                         opp[ipart] = true;
                     }
-                } else {
-                    index[ipart] = -1;
                 }
             }
         } else { // cylinder
+            // Squared distance to the axis
+            for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+                sd[ipart] = 0.;
+            }
+            for( unsigned int idim=0; idim<ndim; idim++ ) {
+                const double *const x1 = s->particles->Position[(idim+1)%ndim].data();
+                const double *const x2 = s->particles->Position[(idim+2)%ndim].data();
+                #pragma omp simd
+                for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+                    double u = ( x1[ipart] - screen_point[(idim+1)%ndim] ) * screen_unitvector[(idim+2)%ndim]
+                             - ( x2[ipart] - screen_point[(idim+2)%ndim] ) * screen_unitvector[(idim+1)%ndim];
+                    sd[ipart] += u * u;
+                }
+            }
             double r2 = screen_vectornorm * screen_vectornorm;
+            double rmin = max( screen_vectornorm - max_displacement, 0. );
+            double rmax = screen_vectornorm + max_displacement;
             for( unsigned int ipart=0; ipart<npart; ipart++ ) {
-                double side = 0.;
+                if( sd[ipart] >= rmin*rmin && sd[ipart] <= rmax*rmax ) {
+                    candidates.push_back( ipart );
+                }
+            }
+            for( unsigned int ic=0; ic<candidates.size(); ic++ ) {
+                unsigned int ipart = candidates[ic];
                 double side_old = 0.;
-                double dtg = dt / s->particles->LorentzFactor( ipart );
+                double dtg = species_dt / s->particles->LorentzFactor( ipart );
                 for( unsigned int idim=0; idim<ndim; idim++ ) {
-                    double u1 = s->particles->Position[(idim+1)%ndim][ipart] - screen_point[(idim+1)%ndim];
-                    double u2 = s->particles->Position[(idim+2)%ndim][ipart] - screen_point[(idim+2)%ndim];
-                    side += pow( u1 * screen_unitvector[(idim+2)%ndim] - u2 * screen_unitvector[(idim+1)%ndim], 2 );
-                    u1 -= dtg * s->particles->Momentum[(idim+1)%ndim][ipart];
-                    u2 -= dtg * s->particles->Momentum[(idim+1)%ndim][ipart];
+                    double u1 = s->particles->Position[(idim+1)%ndim][ipart] - dtg * s->particles->Momentum[(idim+1)%ndim][ipart] - screen_point[(idim+1)%ndim];
+                    double u2 = s->particles->Position[(idim+2)%ndim][ipart] - dtg * s->particles->Momentum[(idim+2)%ndim][ipart] - screen_point[(idim+2)%ndim];
                     side_old += pow( u1 * screen_unitvector[(idim+2)%ndim] - u2 * screen_unitvector[(idim+1)%ndim], 2 );
                 }
-                side     = r2 - side;
+                double side_new = r2 - sd[ipart];
                 side_old = r2 - side_old;
-                if( side*side_old < 0. ) {
+                if( side_new*side_old < 0. ) {
                     index[ipart] = 0;
                     nuseful++;
-                    if( side > 0. ) {
+                    if( side_new > 0. ) {
                         opp[ipart] = true;
                     }
-                } else {
-                    index[ipart] = -1;
                 }
             }
         }
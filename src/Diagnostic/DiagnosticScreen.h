@@ -19,6 +19,13 @@ public :
     
     void run( Patch *patch, int itime, SimWindow *simWindow ) override;
     
+    void updatePatchIndex( VectorPatch &vecPatches, int itime ) override;
+    
+    std::vector<unsigned int> *patchIndex() override
+    {
+        return &patch_index;
+    }
+    
     bool writeNow( int itime ) override;
     
     //! Clear the array
@@ -68,6 +75,15 @@ private :
     
     //! Copy of the timestep
     double dt;
+    
+    //! Whether the screen may cross the given patch
+    bool intersects( Patch *patch );
+    
+    //! Local indices of the patches crossed by the screen
+    std::vector<unsigned int> patch_index;
+    
+    //! Iteration when patch_index was computed (-1 if never)
+    int patch_index_iteration;
 };
 
 #endif
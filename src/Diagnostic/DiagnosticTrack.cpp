@@ -4,6 +4,7 @@
 #include <sstream>
 
 #include "ParticleData.h"
+#include "ParticleFilterExpression.h"
 #include "PeekAtSpecies.h"
 #include "DiagnosticTrack.h"
 #include "VectorPatch.h"
@@ -29,6 +30,7 @@ DiagnosticTrack::DiagnosticTrack( Params &params, SmileiMPI *smpi, VectorPatch &
         ERROR( "DiagTrackParticles #" << iDiagTrackParticles << " does not correspond to any existing species" );
     }
     speciesId_ = species_ids[0];
+    push_every_ = vecPatches( 0 )->vecSpecies[speciesId_]->push_every_;
     
     ostringstream name( "" );
     name << "Tracking species '" << species_name << "'";
@@ -47,7 +49,17 @@ DiagnosticTrack::DiagnosticTrack( Params &params, SmileiMPI *smpi, VectorPatch &
     // Get parameter "filter" which gives a python function to select particles
     filter = PyTools::extract_py( "filter", "DiagTrackParticles", iDiagTrackParticles );
     has_filter = ( filter != Py_None );
-    if( has_filter ) {
+    filter_expression_ = NULL;
+    string filter_string;
+    if( has_filter && PyTools::py2scalar( filter, filter_string ) ) {
+        // Filter given as an expression, evaluated without python
+        filter_expression_ = new ParticleFilterExpression( filter_string, nDim_particle,
+                vecPatches( 0 )->vecSpecies[speciesId_]->particles->isQuantumParameter );
+        if( ! filter_expression_->error().empty() ) {
+            ERROR( name.str() << " filter `" << filter_string << "`: " << filter_expression_->error()
+                   << ". Use a python function for such filters" );
+        }
+    } else if( has_filter ) {
 #ifdef SMILEI_USE_NUMPY
         // Test the filter with temporary, "fake" particles
         name << " filter:";
@@ -58,6 +70,15 @@ DiagnosticTrack::DiagnosticTrack( Params &params, SmileiMPI *smpi, VectorPatch &
 #endif
     }
     
+    // Get parameter "select_once": the filter is applied only once, then the selected particles are kept
+    PyTools::extract( "select_once", select_once_, "DiagTrackParticles", iDiagTrackParticles );
+    if( select_once_ && ! has_filter ) {
+        WARNING( name.str() << ": `select_once` has no effect without a filter" );
+        select_once_ = false;
+    }
+    // After a restart, this is read from the checkpoint
+    selection_done_ = false;
+    
     // Get the parameter "attributes": a list of attribute name that must be written
     vector<string> attributes( 0 );
     if( !PyTools::extractV( "attributes", attributes, "DiagTrackParticles", iDiagTrackParticles ) ) {
@@ -159,6 +180,9 @@ DiagnosticTrack::~DiagnosticTrack()
     delete timeSelection;
     delete flush_timeSelection;
     Py_DECREF( filter );
+    if( filter_expression_ ) {
+        delete filter_expression_;
+    }
     closeFile();
 }
 
@@ -210,7 +234,8 @@ void DiagnosticTrack::init( Params &params, SmileiMPI *smpi, VectorPatch &vecPat
 
 bool DiagnosticTrack::prepare( int itime )
 {
-    return timeSelection->theTimeIsNow( itime );
+    // A sub-cycled species is only written at push iterations, where positions and momenta are up to date
+    return timeSelection->theTimeIsNow( itime ) && itime % ( int )push_every_ == 0;
 }
 
 
@@ -221,13 +246,53 @@ void DiagnosticTrack::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
     
     H5Write *momentum_group=NULL, *position_group=NULL, *species_group=NULL;
     H5Space *file_space=NULL, *mem_space=NULL;
+    
+    // Selection already done once: the tracked particles are those having an ID, the filter is not evaluated
+    bool select_by_id = select_once_ && selection_done_;
+    
+    // Compiled filter or selection by ID: all threads select the particles of their patches
+    if( select_by_id || filter_expression_ ) {
+        #pragma omp single
+        patch_selection.resize( vecPatches.size() );
+        #pragma omp for schedule(runtime)
+        for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+            Particles *p = vecPatches( ipatch )->vecSpecies[speciesId_]->particles;
+            if( select_by_id ) {
+                selectTracked( *p, patch_selection[ipatch] );
+            } else {
+                filter_expression_->select( *p, patch_selection[ipatch] );
+            }
+        }
+    }
+    
     #pragma omp master
     {
         // Obtain the particle partition of all the patches in this MPI
         nParticles_local = 0;
         patch_start.resize( vecPatches.size() );
         
-        if( has_filter ) {
+        if( select_by_id ) {
+            
+            for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+                patch_start[ipatch] = nParticles_local;
+                nParticles_local += patch_selection[ipatch].size();
+            }
+            
+        } else if( filter_expression_ ) {
+            
+            for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+                Particles *p = vecPatches( ipatch )->vecSpecies[speciesId_]->particles;
+                for( unsigned int i=0; i<patch_selection[ipatch].size(); i++ ) {
+                    // If particle not tracked before ( the 7 first bytes (ID<2^56) == 0 ), then set its ID
+                    if( (p->id( patch_selection[ipatch][i] ) & 72057594037927935) == 0 ) {
+                        p->id( patch_selection[ipatch][i] ) += ++latest_Id;
+                    }
+                }
+                patch_start[ipatch] = nParticles_local;
+                nParticles_local += patch_selection[ipatch].size();
+            }
+            
+        } else if( has_filter ) {
         
 #ifdef SMILEI_USE_NUMPY
             patch_selection.resize( vecPatches.size() );
@@ -272,6 +337,9 @@ void DiagnosticTrack::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
                 nParticles_local += vecPatches( ipatch )->vecSpecies[speciesId_]->getNbrOfParticles();
             }
         }
+        if( has_filter ) {
+            selection_done_ = true;
+        }
         
         // Specify the memory dataspace (the size of the local buffer)
         mem_space = new H5Space( (hsize_t)nParticles_local );
@@ -517,6 +585,20 @@ void DiagnosticTrack::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
 }
 
 
+// Select the particles that already passed the filter ( the 7 first bytes of their ID are not 0 )
+void DiagnosticTrack::selectTracked( Particles &particles, vector<unsigned int> &selection )
+{
+    selection.resize( 0 );
+    const uint64_t *const id = particles.getPtrId();
+    const unsigned int npart = particles.size();
+    for( unsigned int i=0; i<npart; i++ ) {
+        if( ( id[i] & 72057594037927935 ) != 0 ) {
+            selection.push_back( i );
+        }
+    }
+}
+
+
 void DiagnosticTrack::setIDs( Patch *patch )
 {
     // If filter, IDs are set on-the-fly
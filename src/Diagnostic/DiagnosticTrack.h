@@ -6,6 +6,7 @@
 class Patch;
 class Params;
 class SmileiMPI;
+class ParticleFilterExpression;
 
 
 class DiagnosticTrack : public Diagnostic
@@ -51,15 +52,24 @@ public :
     //! Set a given particles with the required IDs
     void setIDs( Particles & );
     
+    //! Select the particles of a patch which already have an ID (after a first filtering)
+    void selectTracked( Particles &, std::vector<unsigned int> & );
+    
     //! Index of the species used
     unsigned int speciesId_;
     
+    //! The species is only pushed, thus written, every push_every_ iterations
+    unsigned int push_every_;
+    
     //! Last ID assigned to a particle by this MPI domain
     uint64_t latest_Id;
     
     //! Flag to test whether IDs have been set already
     bool IDs_done;
     
+    //! Whether the filter was already applied (stored in the checkpoints)
+    bool selection_done_;
+    
 private :
     
     H5Write *data_group;
@@ -76,6 +86,12 @@ private :
     //! Tells whether this diag includes a particle filter
     PyObject *filter;
     
+    //! Filter given as a string expression, evaluated without python (NULL otherwise)
+    ParticleFilterExpression *filter_expression_;
+    
+    //! Whether the filter is applied only once, the selected particles being tracked afterwards
+    bool select_once_;
+    
     //! Selection of the filtered particles in each patch
     std::vector<std::vector<unsigned int> > patch_selection;
     
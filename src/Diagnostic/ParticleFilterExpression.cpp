@@ -0,0 +1,503 @@
+#include "ParticleFilterExpression.h"
+
+#include <cmath>
+#include <cctype>
+#include <cstdlib>
+#include <algorithm>
+
+#include "Particles.h"
+
+using namespace std;
+
+ParticleFilterExpression::ParticleFilterExpression( string expression, unsigned int nDim_particle, bool has_chi ) :
+    stack_depth_( 0 ),
+    nDim_particle_( nDim_particle ),
+    has_chi_( has_chi ),
+    itoken_( 0 )
+{
+    if( ! tokenize( expression ) ) {
+        return;
+    }
+    if( tokens_.empty() ) {
+        error_ = "empty expression";
+        return;
+    }
+    if( ! parseOr() ) {
+        return;
+    }
+    if( itoken_ < tokens_.size() ) {
+        error_ = "unexpected `" + tokens_[itoken_] + "`";
+        return;
+    }
+
+    // Depth of the evaluation stack
+    int depth = 0, max_depth = 0;
+    for( unsigned int i=0; i<program_.size(); i++ ) {
+        switch( program_[i].operation ) {
+            case PUSH_CONST: case PUSH_VAR:
+                depth++;
+                break;
+            case NEG: case NOT: case SQUARE: case ABS: case SQRT: case EXP: case LOG:
+                break;
+            default:
+                depth--;
+        }
+        max_depth = max( depth, max_depth );
+    }
+    stack_depth_ = max_depth;
+}
+
+bool ParticleFilterExpression::tokenize( const string &e )
+{
+    unsigned int i = 0;
+    while( i < e.size() ) {
+        char c = e[i];
+        if( isspace( c ) ) {
+            i++;
+        } else if( isdigit( c ) || ( c == '.' && i+1 < e.size() && isdigit( e[i+1] ) ) ) {
+            // Number, possibly with an exponent
+            unsigned int j = i;
+            while( j < e.size() && ( isdigit( e[j] ) || e[j] == '.' ) ) {
+                j++;
+            }
+            if( j < e.size() && ( e[j] == 'e' || e[j] == 'E' ) ) {
+                unsigned int k = j+1;
+                if( k < e.size() && ( e[k] == '+' || e[k] == '-' ) ) {
+                    k++;
+                }
+                if( k < e.size() && isdigit( e[k] ) ) {
+                    j = k;
+                    while( j < e.size() && isdigit( e[j] ) ) {
+                        j++;
+                    }
+                }
+            }
+            tokens_.push_back( e.substr( i, j-i ) );
+            i = j;
+        } else if( isalpha( c ) || c == '_' ) {
+            unsigned int j = i;
+            while( j < e.size() && ( isalnum( e[j] ) || e[j] == '_' ) ) {
+                j++;
+            }
+            tokens_.push_back( e.substr( i, j-i ) );
+            i = j;
+        } else {
+            string two = e.substr( i, 2 );
+            if( two == "**" || two == "<=" || two == ">=" || two == "==" || two == "!=" ) {
+                tokens_.push_back( two );
+                i += 2;
+            } else if( string( "+-*/<>()&|~" ).find( c ) != string::npos ) {
+                tokens_.push_back( string( 1, c ) );
+                i++;
+            } else {
+                error_ = string( "unexpected character `" ) + c + "`";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+string ParticleFilterExpression::peek() const
+{
+    return itoken_ < tokens_.size() ? tokens_[itoken_] : "";
+}
+
+bool ParticleFilterExpression::accept( string token )
+{
+    if( peek() == token ) {
+        itoken_++;
+        return true;
+    }
+    return false;
+}
+
+void ParticleFilterExpression::emit( Operation operation, double value )
+{
+    Instruction instruction;
+    instruction.operation = operation;
+    instruction.value = value;
+    program_.push_back( instruction );
+}
+
+bool ParticleFilterExpression::parseOr()
+{
+    if( ! parseAnd() ) {
+        return false;
+    }
+    while( accept( "or" ) || accept( "|" ) ) {
+        if( ! parseAnd() ) {
+            return false;
+        }
+        emit( OR );
+    }
+    return true;
+}
+
+bool ParticleFilterExpression::parseAnd()
+{
+    if( ! parseNot() ) {
+        return false;
+    }
+    while( accept( "and" ) || accept( "&" ) ) {
+        if( ! parseNot() ) {
+            return false;
+        }
+        emit( AND );
+    }
+    return true;
+}
+
+bool ParticleFilterExpression::parseNot()
+{
+    if( accept( "not" ) || accept( "~" ) ) {
+        if( ! parseNot() ) {
+            return false;
+        }
+        emit( NOT );
+        return true;
+    }
+    return parseComparison();
+}
+
+bool ParticleFilterExpression::parseComparison()
+{
+    if( ! parseSum() ) {
+        return false;
+    }
+    const string comparisons[6] = { "<", "<=", ">", ">=", "==", "!=" };
+    const Operation operations[6] = { LT, LE, GT, GE, EQ, NE };
+    for( unsigned int i=0; i<6; i++ ) {
+        if( accept( comparisons[i] ) ) {
+            if( ! parseSum() ) {
+                return false;
+            }
+            emit( operations[i] );
+            for( unsigned int j=0; j<6; j++ ) {
+                if( peek() == comparisons[j] ) {
+                    error_ = "chained comparisons are not supported, use `and`";
+                    return false;
+                }
+            }
+            break;
+        }
+    }
+    return true;
+}
+
+bool ParticleFilterExpression::parseSum()
+{
+    if( ! parseTerm() ) {
+        return false;
+    }
+    while( true ) {
+        if( accept( "+" ) ) {
+            if( ! parseTerm() ) {
+                return false;
+            }
+            emit( ADD );
+        } else if( accept( "-" ) ) {
+            if( ! parseTerm() ) {
+                return false;
+            }
+            emit( SUB );
+        } else {
+            return true;
+        }
+    }
+}
+
+bool ParticleFilterExpression::parseTerm()
+{
+    if( ! parseUnary() ) {
+        return false;
+    }
+    while( true ) {
+        if( accept( "*" ) ) {
+            if( ! parseUnary() ) {
+                return false;
+            }
+            emit( MUL );
+        } else if( accept( "/" ) ) {
+            if( ! parseUnary() ) {
+                return false;
+            }
+            emit( DIV );
+        } else {
+            return true;
+        }
+    }
+}
+
+bool ParticleFilterExpression::parseUnary()
+{
+    if( accept( "-" ) ) {
+        if( ! parseUnary() ) {
+            return false;
+        }
+        emit( NEG );
+        return true;
+    }
+    if( accept( "+" ) ) {
+        return parseUnary();
+    }
+    return parsePower();
+}
+
+bool ParticleFilterExpression::parsePower()
+{
+    if( ! parseAtom() ) {
+        return false;
+    }
+    if( accept( "**" ) ) {
+        // Right-associative, and binds tighter than a unary minus on its left
+        if( ! parseUnary() ) {
+            return false;
+        }
+        if( program_.back().operation == PUSH_CONST && program_.back().value == 2. ) {
+            program_.pop_back();
+            emit( SQUARE );
+        } else {
+            emit( POW );
+        }
+    }
+    return true;
+}
+
+bool ParticleFilterExpression::parseAtom()
+{
+    string token = peek();
+    if( token.empty() ) {
+        error_ = "unexpected end of expression";
+        return false;
+    }
+    itoken_++;
+
+    // Parentheses
+    if( token == "(" ) {
+        if( ! parseOr() ) {
+            return false;
+        }
+        if( ! accept( ")" ) ) {
+            error_ = "missing `)`";
+            return false;
+        }
+        return true;
+    }
+
+    // Number
+    if( isdigit( token[0] ) || token[0] == '.' ) {
+        emit( PUSH_CONST, strtod( token.c_str(), NULL ) );
+        return true;
+    }
+
+    // Functions
+    const string functions[4] = { "abs", "sqrt", "exp", "log" };
+    const Operation operations[4] = { ABS, SQRT, EXP, LOG };
+    for( unsigned int i=0; i<4; i++ ) {
+        if( token == functions[i] ) {
+            if( ! accept( "(" ) ) {
+                error_ = "missing `(` after `" + token + "`";
+                return false;
+            }
+            if( ! parseOr() ) {
+                return false;
+            }
+            if( ! accept( ")" ) ) {
+                error_ = "missing `)`";
+                return false;
+            }
+            emit( operations[i] );
+            return true;
+        }
+    }
+
+    // Variables
+    int variable = -1;
+    if( token == "x" ) {
+        variable = POS_X;
+    } else if( token == "y" && nDim_particle_ > 1 ) {
+        variable = POS_Y;
+    } else if( token == "z" && nDim_particle_ > 2 ) {
+        variable = POS_Z;
+    } else if( token == "px" ) {
+        variable = MOM_X;
+    } else if( token == "py" ) {
+        variable = MOM_Y;
+    } else if( token == "pz" ) {
+        variable = MOM_Z;
+    } else if( token == "weight" || token == "w" ) {
+        variable = WEIGHT;
+    } else if( token == "charge" || token == "q" ) {
+        variable = CHARGE;
+    } else if( token == "chi" && has_chi_ ) {
+        variable = CHI;
+    }
+    if( variable < 0 ) {
+        error_ = "unknown or unavailable variable `" + token + "`";
+        return false;
+    }
+    emit( PUSH_VAR, variable );
+    return true;
+}
+
+void ParticleFilterExpression::select( Particles &particles, vector<unsigned int> &selection ) const
+{
+    selection.resize( 0 );
+    unsigned int npart = particles.size();
+    if( npart == 0 ) {
+        return;
+    }
+
+    const double *variables[9] = {
+        particles.getPtrPosition( 0 ),
+        nDim_particle_ > 1 ? particles.getPtrPosition( 1 ) : NULL,
+        nDim_particle_ > 2 ? particles.getPtrPosition( 2 ) : NULL,
+        particles.getPtrMomentum( 0 ),
+        particles.getPtrMomentum( 1 ),
+        particles.getPtrMomentum( 2 ),
+        particles.getPtrWeight(),
+        NULL,
+        has_chi_ ? particles.getPtrChi() : NULL
+    };
+    const short *charge = particles.getPtrCharge();
+
+    vector<double> stack( max( stack_depth_, 1u ) * chunk_size );
+
+    for( unsigned int istart=0; istart<npart; istart+=chunk_size ) {
+        const int n = npart-istart < chunk_size ? npart-istart : chunk_size;
+        // Top of the stack: s[-1] ( and s[-2] for binary operations )
+        double *s = &stack[0];
+        for( unsigned int i=0; i<program_.size(); i++ ) {
+            const Operation operation = program_[i].operation;
+            if( operation == PUSH_CONST ) {
+                const double value = program_[i].value;
+                #pragma omp simd
+                for( int ip=0; ip<n; ip++ ) {
+                    s[ip] = value;
+                }
+                s += chunk_size;
+                continue;
+            }
+            if( operation == PUSH_VAR ) {
+                const int variable = ( int )program_[i].value;
+                if( variable == CHARGE ) {
+                    #pragma omp simd
+                    for( int ip=0; ip<n; ip++ ) {
+                        s[ip] = ( double )charge[istart+ip];
+                    }
+                } else {
+                    const double *v = variables[variable] + istart;
+                    #pragma omp simd
+                    for( int ip=0; ip<n; ip++ ) {
+                        s[ip] = v[ip];
+                    }
+                }
+                s += chunk_size;
+                continue;
+            }
+
+            // Unary operations act on the top of the stack
+            double *a = s - chunk_size;
+            switch( operation ) {
+                case NEG:
+                    #pragma omp simd
+                    for( int ip=0; ip<n; ip++ ) a[ip] = -a[ip];
+                    continue;
+                case NOT:
+                    #pragma omp simd
+                    for( int ip=0; ip<n; ip++ ) a[ip] = a[ip] == 0. ? 1. : 0.;
+                    continue;
+                case SQUARE:
+                    #pragma omp simd
+                    for( int ip=0; ip<n; ip++ ) a[ip] *= a[ip];
+                    continue;
+                case ABS:
+                    #pragma omp simd
+                    for( int ip=0; ip<n; ip++ ) a[ip] = std::abs( a[ip] );
+                    continue;
+                case SQRT:
+                    #pragma omp simd
+                    for( int ip=0; ip<n; ip++ ) a[ip] = std::sqrt( a[ip] );
+                    continue;
+                case EXP:
+                    #pragma omp simd
+                    for( int ip=0; ip<n; ip++ ) a[ip] = std::exp( a[ip] );
+                    continue;
+                case LOG:
+                    #pragma omp simd
+                    for( int ip=0; ip<n; ip++ ) a[ip] = std::log( a[ip] );
+                    continue;
+                default:
+                    break;
+            }
+
+            // Binary operations: a = a (op) b, and the stack is popped
+            double *b = a;
+            a -= chunk_size;
+            switch( operation ) {
+                case ADD:
+                    #pragma omp simd
+                    for( int ip=0; ip<n; ip++ ) a[ip] += b[ip];
+                    break;
+                case SUB:
+                    #pragma omp simd
+                    for( int ip=0; ip<n; ip++ ) a[ip] -= b[ip];
+                    break;
+                case MUL:
+                    #pragma omp simd
+                    for( int ip=0; ip<n; ip++ ) a[ip] *= b[ip];
+                    break;
+                case DIV:
+                    #pragma omp simd
+                    for( int ip=0; ip<n; ip++ ) a[ip] /= b[ip];
+                    break;
+                case POW:
+                    for( int ip=0; ip<n; ip++ ) a[ip] = std::pow( a[ip], b[ip] );
+                    break;
+                case LT:
+                    #pragma omp simd
+                    for( int ip=0; ip<n; ip++ ) a[ip] = a[ip] < b[ip] ? 1. : 0.;
+                    break;
+                case LE:
+                    #pragma omp simd
+                    for( int ip=0; ip<n; ip++ ) a[ip] = a[ip] <= b[ip] ? 1. : 0.;
+                    break;
+                case GT:
+                    #pragma omp simd
+                    for( int ip=0; ip<n; ip++ ) a[ip] = a[ip] > b[ip] ? 1. : 0.;
+                    break;
+                case GE:
+                    #pragma omp simd
+                    for( int ip=0; ip<n; ip++ ) a[ip] = a[ip] >= b[ip] ? 1. : 0.;
+                    break;
+                case EQ:
+                    #pragma omp simd
+                    for( int ip=0; ip<n; ip++ ) a[ip] = a[ip] == b[ip] ? 1. : 0.;
+                    break;
+                case NE:
+                    #pragma omp simd
+                    for( int ip=0; ip<n; ip++ ) a[ip] = a[ip] != b[ip] ? 1. : 0.;
+                    break;
+                case AND:
+                    #pragma omp simd
+                    for( int ip=0; ip<n; ip++ ) a[ip] = ( a[ip] != 0. && b[ip] != 0. ) ? 1. : 0.;
+                    break;
+                case OR:
+                    #pragma omp simd
+                    for( int ip=0; ip<n; ip++ ) a[ip] = ( a[ip] != 0. || b[ip] != 0. ) ? 1. : 0.;
+                    break;
+                default:
+                    break;
+            }
+            s = b;
+        }
+
+        // The result is the only value left in the stack
+        for( int ip=0; ip<n; ip++ ) {
+            if( stack[ip] != 0. ) {
+                selection.push_back( istart+ip );
+            }
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef PARTICLEFILTEREXPRESSION_H
+#define PARTICLEFILTEREXPRESSION_H
+
+#include <string>
+#include <vector>
+
+class Particles;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class ParticleFilterExpression
+//! Particle selection given as a string, such as "px**2+py**2 > 100 and x < 50", evaluated in C++
+//! without calling python. The expression is parsed once into a postfix program which is then
+//! evaluated on chunks of particles, each instruction being a vectorizable loop.
+//!
+//! Variables: x, y, z, px, py, pz, weight (w), charge (q), chi
+//! Operators: + - * / ** < <= > >= == != and or not (or & | ~), with the python precedence
+//! Functions: abs, sqrt, exp, log
+//  --------------------------------------------------------------------------------------------------------------------
+class ParticleFilterExpression
+{
+public:
+    //! Parse the expression. If it is invalid, error() is not empty.
+    ParticleFilterExpression( std::string expression, unsigned int nDim_particle, bool has_chi );
+    ~ParticleFilterExpression() {};
+
+    //! Empty if the expression is valid, error message otherwise
+    inline std::string error() const
+    {
+        return error_;
+    }
+
+    //! Fill `selection` with the indices of the particles satisfying the expression (thread-safe)
+    void select( Particles &particles, std::vector<unsigned int> &selection ) const;
+
+private:
+
+    enum Operation {
+        PUSH_CONST, PUSH_VAR,
+        ADD, SUB, MUL, DIV, POW, SQUARE, NEG,
+        LT, LE, GT, GE, EQ, NE,
+        AND, OR, NOT,
+        ABS, SQRT, EXP, LOG
+    };
+    enum Variable {
+        POS_X, POS_Y, POS_Z, MOM_X, MOM_Y, MOM_Z, WEIGHT, CHARGE, CHI
+    };
+    struct Instruction {
+        Operation operation;
+        //! Constant value (PUSH_CONST) or variable index (PUSH_VAR)
+        double value;
+    };
+
+    //! Number of particles evaluated at once
+    static const unsigned int chunk_size = 256;
+
+    //! Postfix program
+    std::vector<Instruction> program_;
+    //! Maximum depth of the evaluation stack
+    unsigned int stack_depth_;
+
+    unsigned int nDim_particle_;
+    bool has_chi_;
+    std::string error_;
+
+    // Recursive descent parser
+    std::vector<std::string> tokens_;
+    unsigned int itoken_;
+    bool tokenize( const std::string &expression );
+    std::string peek() const;
+    bool accept( std::string token );
+    void emit( Operation operation, double value = 0. );
+    bool parseOr();
+    bool parseAnd();
+    bool parseNot();
+    bool parseComparison();
+    bool parseSum();
+    bool parseTerm();
+    bool parseUnary();
+    bool parsePower();
+    bool parseAtom();
+};
+
+#endif
@@ -0,0 +1,137 @@
+#include "ProbeGridStencil.h"
+
+#include <cmath>
+
+#include "Field.h"
+#include "Particles.h"
+
+using namespace std;
+
+ProbeGridStencil::ProbeGridStencil( Particles &points,
+                                    vector<unsigned int> axis_dimension,
+                                    vector<unsigned int> axis_number,
+                                    vector<int> domain_begin,
+                                    vector<double> cell_length )
+{
+    nDim_ = cell_length.size();
+
+    for( unsigned int a=0; a<3; a++ ) {
+        axis_number_[a] = a<axis_number.size() ? axis_number[a] : 1;
+    }
+    for( unsigned int d=0; d<3; d++ ) {
+        dimension_axis_[d] = 3;
+    }
+    for( unsigned int a=0; a<axis_dimension.size(); a++ ) {
+        dimension_axis_[axis_dimension[a]] = a;
+    }
+
+    for( unsigned int d=0; d<nDim_; d++ ) {
+        // Points along this dimension are separated by `stride` in the list of points
+        unsigned int a = dimension_axis_[d];
+        unsigned int n = 1, stride = 0;
+        if( a < 3 ) {
+            n = axis_number_[a];
+            stride = 1;
+            for( unsigned int b=0; b<a; b++ ) {
+                stride *= axis_number_[b];
+            }
+        }
+        double d_inv = 1.0/cell_length[d];
+        for( unsigned int s=0; s<2; s++ ) {
+            index_[d][s].resize( n );
+            coeff_[d][s].resize( 3*n );
+        }
+        for( unsigned int m=0; m<n; m++ ) {
+            double xpn = points.position( d, m*stride )*d_inv;
+            // Same coefficients as the 2nd order interpolators, on the primal (s=0) and dual (s=1) grids
+            for( unsigned int s=0; s<2; s++ ) {
+                int ic = round( xpn + 0.5*s );
+                double delta  = xpn - ( double )ic + 0.5*s;
+                double delta2 = delta*delta;
+                coeff_[d][s][3*m  ] = 0.5 * ( delta2-delta+0.25 );
+                coeff_[d][s][3*m+1] = 0.75 - delta2;
+                coeff_[d][s][3*m+2] = 0.5 * ( delta2+delta+0.25 );
+                index_[d][s][m] = ic - 1 - domain_begin[d];
+            }
+        }
+    }
+}
+
+void ProbeGridStencil::interpolate( Field *field, double *out ) const
+{
+    if( nDim_ == 1 ) {
+        interpolate<1>( field, out );
+    } else if( nDim_ == 2 ) {
+        interpolate<2>( field, out );
+    } else {
+        interpolate<3>( field, out );
+    }
+}
+
+template<int nDim>
+void ProbeGridStencil::interpolate( Field *field, double *out ) const
+{
+    const double *const __restrict__ f = field->data_;
+
+    // Strides of the field array
+    unsigned int sf[3] = { 1, 1, 1 };
+    for( int d=nDim-1; d>0; d-- ) {
+        sf[d-1] = sf[d] * field->dims_[d];
+    }
+
+    // Stencils on the right grid (primal or dual) for each dimension
+    const int *index[3] = { NULL, NULL, NULL };
+    const double *coeff[3] = { NULL, NULL, NULL };
+    for( int d=0; d<nDim; d++ ) {
+        index[d] = index_[d][field->isDual( d )].data();
+        coeff[d] = coeff_[d][field->isDual( d )].data();
+    }
+    const int *const __restrict__ ix = index[0];
+    const int *const __restrict__ iy = index[1];
+    const int *const __restrict__ iz = index[2];
+    const double *const __restrict__ cx = coeff[0];
+    const double *const __restrict__ cy = coeff[1];
+    const double *const __restrict__ cz = coeff[2];
+
+    for( unsigned int m2=0; m2<axis_number_[2]; m2++ ) {
+        for( unsigned int m1=0; m1<axis_number_[1]; m1++ ) {
+
+            // Coordinate indices are either fixed in the inner loop, or follow the first probe axis
+            unsigned int fixed[3] = { 0, 0, 0 }, inner[3] = { 0, 0, 0 };
+            for( int d=0; d<nDim; d++ ) {
+                unsigned int a = dimension_axis_[d];
+                fixed[d] = a==1 ? m1 : ( a==2 ? m2 : 0 );
+                inner[d] = a==0 ? 1 : 0;
+            }
+            double *const __restrict__ o = out + ( m2*axis_number_[1] + m1 )*axis_number_[0];
+
+            #pragma omp simd
+            for( unsigned int m0=0; m0<axis_number_[0]; m0++ ) {
+                unsigned int mx = fixed[0] + inner[0]*m0;
+                unsigned int my = fixed[1] + inner[1]*m0;
+                unsigned int mz = fixed[2] + inner[2]*m0;
+                double v = 0.;
+                if( nDim == 1 ) {
+                    for( int i=0; i<3; i++ ) {
+                        v += cx[3*mx+i] * f[ix[mx]+i];
+                    }
+                } else if( nDim == 2 ) {
+                    for( int i=0; i<3; i++ ) {
+                        for( int j=0; j<3; j++ ) {
+                            v += cx[3*mx+i] * cy[3*my+j] * f[( ix[mx]+i )*sf[0] + iy[my]+j];
+                        }
+                    }
+                } else {
+                    for( int i=0; i<3; i++ ) {
+                        for( int j=0; j<3; j++ ) {
+                            for( int k=0; k<3; k++ ) {
+                                v += cx[3*mx+i] * cy[3*my+j] * cz[3*mz+k] * f[( ix[mx]+i )*sf[0] + ( iy[my]+j )*sf[1] + iz[mz]+k];
+                            }
+                        }
+                    }
+                }
+                o[m0] = v;
+            }
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef PROBEGRIDSTENCIL_H
+#define PROBEGRIDSTENCIL_H
+
+#include <vector>
+
+class Field;
+class Particles;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class ProbeGridStencil
+//! Interpolation stencils of the points of an axis-aligned probe, in one patch.
+//! The points of such a probe form a tensor product of 1D sets of coordinates, so that the 2nd order
+//! interpolation coefficients are computed once per coordinate (for both primal and dual grids) when the
+//! points are created. Fields are then resampled directly from the Field arrays with separable stencils,
+//! instead of treating each point as a particle in the Interpolator.
+//  --------------------------------------------------------------------------------------------------------------------
+class ProbeGridStencil
+{
+public:
+    //! `points` must be ordered with the first probe axis varying fastest.
+    //! `axis_dimension[a]` is the field dimension along which probe axis `a` is oriented,
+    //! `axis_number[a]` is the number of points of this patch along probe axis `a`.
+    ProbeGridStencil( Particles &points,
+                      std::vector<unsigned int> axis_dimension,
+                      std::vector<unsigned int> axis_number,
+                      std::vector<int> domain_begin,
+                      std::vector<double> cell_length );
+    ~ProbeGridStencil() {};
+
+    //! Interpolate `field` on all points. `out` must hold one value per point.
+    void interpolate( Field *field, double *out ) const;
+
+private:
+
+    template<int nDim>
+    void interpolate( Field *field, double *out ) const;
+
+    //! Number of field dimensions
+    unsigned int nDim_;
+
+    //! Number of points along each probe axis (padded with 1 up to 3 axes)
+    unsigned int axis_number_[3];
+
+    //! For each field dimension, the probe axis along which the coordinate varies (3 if constant)
+    unsigned int dimension_axis_[3];
+
+    //! For each field dimension and each grid (0 primal, 1 dual): first index of the stencil for each coordinate
+    std::vector<int> index_[3][2];
+
+    //! For each field dimension and each grid (0 primal, 1 dual): 3 coefficients for each coordinate
+    std::vector<double> coeff_[3][2];
+};
+
+#endif
@@ -288,6 +288,14 @@ void TimeSelection::set( double new_start, double new_end, double new_period )
     period = new_period;
 }
 
+//! Change the period, the next selected timestep becoming itime + new_period
+void TimeSelection::setPeriod( int itime, double new_period )
+{
+    start  = itime + new_period;
+    period = new_period;
+    SmallestInterval = ( repeat<=1 ) ? ( ( int )period ) : ( ( int )spacing );
+}
+
 //! Obtain some information about the time selection
 std::string TimeSelection::info()
 {
@@ -82,6 +82,21 @@ public:
     //! Set the parameters of the time selection
     void set( double start, double end, double period );
     
+    //! Change the period, the next selected timestep becoming itime + new_period
+    void setPeriod( int itime, double new_period );
+    
+    //! Get the period between each group
+    inline double getPeriod()
+    {
+        return period;
+    };
+    
+    //! Tell whether the selection is a plain period (no repeats)
+    inline bool isRegular()
+    {
+        return repeat == 1;
+    };
+    
     //! Obtain some information about the time selection
     std::string info();
     
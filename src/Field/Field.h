@@ -4,6 +4,7 @@
 #include <cmath>
 
 #include <vector>
+#include <algorithm>
 #include <cstdlib>
 #include <string>
 #include <iostream>
@@ -69,7 +70,12 @@ public:
     //! Destructor for Field
     virtual ~Field()
     {
-        ;
+        for( unsigned int iside=0 ; iside<sendFieldsSpare_.size() ; iside++ ) {
+            if( sendFieldsSpare_[iside] != NULL ) {
+                delete sendFieldsSpare_[iside];
+                delete recvFieldsSpare_[iside];
+            }
+        }
     };
 
     //! Virtual method used to allocate Field
@@ -83,6 +89,9 @@ public:
     //! Virtual method to deallocate Field
     virtual void deallocateDataAndSetTo( Field* f ) = 0;
 
+    //! Virtual method to free the data, keeping the dimensions (allocateDims() allocates it again)
+    virtual void deallocateData() = 0;
+
     //! Virtual method to shift field in space
     virtual void shift_x( unsigned int delta ) = 0;
 
@@ -243,6 +252,35 @@ public:
 
     std::vector<Field*> sendFields_;
     std::vector<Field*> recvFields_;
+    //! Sub-fields of the other ghost size, kept for the next sum or exchange (sum and exchange do not use the same ghost size)
+    std::vector<Field*> sendFieldsSpare_;
+    std::vector<Field*> recvFieldsSpare_;
+    //! Number of sub-field allocations by create_sub_fields (a new sub-field may reuse the address of a deleted one)
+    unsigned int sub_fields_allocations_ = 0;
+
+    //! Swap the sub-fields of (iDim, iNeighbor) with the spare ones.
+    //! Return true if no sub-field of the requested ghost_size is available, i.e. they must be allocated
+    bool switchSubFields( int iDim, int iNeighbor, int ghost_size )
+    {
+        int iside = iDim*2+iNeighbor;
+        if( sendFieldsSpare_.size() != sendFields_.size() ) {
+            sendFieldsSpare_.resize( sendFields_.size(), NULL );
+            recvFieldsSpare_.resize( recvFields_.size(), NULL );
+        }
+        std::swap( sendFields_[iside], sendFieldsSpare_[iside] );
+        std::swap( recvFields_[iside], recvFieldsSpare_[iside] );
+        if( sendFields_[iside] == NULL ) {
+            return true;
+        }
+        if( ghost_size != ( int )( sendFields_[iside]->dims_[iDim] ) ) {
+            delete sendFields_[iside];
+            sendFields_[iside] = NULL;
+            delete recvFields_[iside];
+            recvFields_[iside] = NULL;
+            return true;
+        }
+        return false;
+    }
     virtual void create_sub_fields  ( int iDim, int iNeighbor, int ghost_size ) = 0;
     virtual void extract_fields_exch( int iDim, int iNeighbor, int ghost_size ) = 0;
     virtual void inject_fields_exch ( int iDim, int iNeighbor, int ghost_size ) = 0;
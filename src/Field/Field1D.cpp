@@ -113,6 +113,12 @@ void Field1D::deallocateDataAndSetTo( Field* f )
     data_ = f->data_;
 }
 
+void Field1D::deallocateData()
+{
+    delete [] data_;
+    data_ = NULL;
+}
+
 
 void Field1D::allocateDims( unsigned int dims1 )
 {
@@ -236,15 +242,18 @@ void Field1D::create_sub_fields  ( int iDim, int iNeighbor, int ghost_size )
 {
     std::vector<unsigned int> n_space = dims_;
     n_space[iDim] = ghost_size;
-    if ( sendFields_[iDim*2+iNeighbor] == NULL ) {
+    if( sendFields_[iDim*2+iNeighbor] == NULL ) {
         sendFields_[iDim*2+iNeighbor] = new Field1D(n_space);
         recvFields_[iDim*2+iNeighbor] = new Field1D(n_space);
+        sub_fields_allocations_++;
     }
     else if( ghost_size != (int) sendFields_[iDim*2+iNeighbor]->dims_[iDim] ) {
-        delete sendFields_[iDim*2+iNeighbor];
-        sendFields_[iDim*2+iNeighbor] = new Field1D(n_space);
-        delete recvFields_[iDim*2+iNeighbor];
-        recvFields_[iDim*2+iNeighbor] = new Field1D(n_space);
+        // Sub-fields of the previous ghost size are kept as spare ones, to be reused at the next call
+        if( switchSubFields( iDim, iNeighbor, ghost_size ) ) {
+            sendFields_[iDim*2+iNeighbor] = new Field1D(n_space);
+            recvFields_[iDim*2+iNeighbor] = new Field1D(n_space);
+            sub_fields_allocations_++;
+        }
     }
 }
 
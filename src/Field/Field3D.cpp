@@ -137,6 +137,20 @@ void Field3D::deallocateDataAndSetTo( Field* f )
     
 }
 
+void Field3D::deallocateData()
+{
+    if( data_ == NULL ) {
+        return;
+    }
+    delete [] data_;
+    data_ = NULL;
+    for( unsigned int i=0; i<dims_[0]; i++ ) {
+        delete [] data_3D[i];
+    }
+    delete [] data_3D;
+    data_3D = NULL;
+}
+
 
 void Field3D::allocateDims( unsigned int dims1, unsigned int dims2, unsigned int dims3 )
 {
@@ -334,12 +348,15 @@ void Field3D::create_sub_fields  ( int iDim, int iNeighbor, int ghost_size )
     if( sendFields_[iDim*2+iNeighbor] == NULL ) {
         sendFields_[iDim*2+iNeighbor] = new Field3D(n_space);
         recvFields_[iDim*2+iNeighbor] = new Field3D(n_space);
+        sub_fields_allocations_++;
     }
     else if( ghost_size != (int) sendFields_[iDim*2+iNeighbor]->dims_[iDim] ) {
-        delete sendFields_[iDim*2+iNeighbor];
-        sendFields_[iDim*2+iNeighbor] = new Field3D(n_space);
-        delete recvFields_[iDim*2+iNeighbor];
-        recvFields_[iDim*2+iNeighbor] = new Field3D(n_space);
+        // Sub-fields of the previous ghost size are kept as spare ones, to be reused at the next call
+        if( switchSubFields( iDim, iNeighbor, ghost_size ) ) {
+            sendFields_[iDim*2+iNeighbor] = new Field3D(n_space);
+            recvFields_[iDim*2+iNeighbor] = new Field3D(n_space);
+            sub_fields_allocations_++;
+        }
     }
 }
 
@@ -50,6 +50,7 @@ public:
     //! Method used to allocate a cField
     virtual void allocateDims() override = 0;
     virtual void deallocateDataAndSetTo( Field* f ) override = 0;
+    virtual void deallocateData() override = 0;
     //! a cField can also be initialized win two unsigned int
 //    void allocateDims(unsigned int dims1,unsigned int dims2,unsigned int dims3);
 //    //! allocate dimensions for field3D isPrimal define if mainDim is Primal or Dual
@@ -137,6 +137,14 @@ void cField2D::deallocateDataAndSetTo( Field* f )
     
 }
 
+void cField2D::deallocateData()
+{
+    delete [] cdata_;
+    cdata_ = NULL;
+    delete [] data_2D;
+    data_2D = NULL;
+}
+
 void cField2D::allocateDims( unsigned int dims1, unsigned int dims2 )
 {
     vector<unsigned int> dims( 2 );
@@ -318,15 +326,18 @@ void cField2D::create_sub_fields  ( int iDim, int iNeighbor, int ghost_size )
 {
     std::vector<unsigned int> n_space = dims_;
     n_space[iDim] = ghost_size;
-    if ( sendFields_[iDim*2+iNeighbor] == NULL ) {
+    if( sendFields_[iDim*2+iNeighbor] == NULL ) {
         sendFields_[iDim*2+iNeighbor] = new cField2D(n_space);
         recvFields_[iDim*2+iNeighbor] = new cField2D(n_space);
+        sub_fields_allocations_++;
     }
-    else if ( ghost_size != int(sendFields_[iDim*2+iNeighbor]->dims_[iDim]) ) {
-        delete sendFields_[iDim*2+iNeighbor];
-        sendFields_[iDim*2+iNeighbor] = new cField2D(n_space);
-        delete recvFields_[iDim*2+iNeighbor];
-        recvFields_[iDim*2+iNeighbor] = new cField2D(n_space);
+    else if( ghost_size != (int) sendFields_[iDim*2+iNeighbor]->dims_[iDim] ) {
+        // Sub-fields of the previous ghost size are kept as spare ones, to be reused at the next call
+        if( switchSubFields( iDim, iNeighbor, ghost_size ) ) {
+            sendFields_[iDim*2+iNeighbor] = new cField2D(n_space);
+            recvFields_[iDim*2+iNeighbor] = new cField2D(n_space);
+            sub_fields_allocations_++;
+        }
     }
 }
 
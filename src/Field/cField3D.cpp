@@ -129,6 +129,20 @@ void cField3D::deallocateDataAndSetTo( Field* f )
 
 }
 
+void cField3D::deallocateData()
+{
+    if( cdata_ == NULL ) {
+        return;
+    }
+    delete [] cdata_;
+    cdata_ = NULL;
+    for( unsigned int i=0; i<dims_[0]; i++ ) {
+        delete [] data_3D[i];
+    }
+    delete [] data_3D;
+    data_3D = NULL;
+}
+
 void cField3D::allocateDims( unsigned int dims1, unsigned int dims2, unsigned int dims3 )
 {
     vector<unsigned int> dims( 3 );
@@ -282,15 +296,16 @@ void cField3D::create_sub_fields  ( int iDim, int iNeighbor, int ghost_size )
 {
     std::vector<unsigned int> n_space = dims_;
     n_space[iDim] = ghost_size;
-    if ( sendFields_[iDim*2+iNeighbor] == NULL ) {
+    if( sendFields_[iDim*2+iNeighbor] == NULL ) {
         sendFields_[iDim*2+iNeighbor] = new cField3D(n_space);
         recvFields_[iDim*2+iNeighbor] = new cField3D(n_space);
     }
-    else if ( (unsigned int)(ghost_size) != sendFields_[iDim*2+iNeighbor]->dims_[iDim] ) {
-        delete sendFields_[iDim*2+iNeighbor];
-        sendFields_[iDim*2+iNeighbor] = new cField3D(n_space);
-        delete recvFields_[iDim*2+iNeighbor];
-        recvFields_[iDim*2+iNeighbor] = new cField3D(n_space);
+    else if( ghost_size != (int) sendFields_[iDim*2+iNeighbor]->dims_[iDim] ) {
+        // Sub-fields of the previous ghost size are kept as spare ones, to be reused at the next call
+        if( switchSubFields( iDim, iNeighbor, ghost_size ) ) {
+            sendFields_[iDim*2+iNeighbor] = new cField3D(n_space);
+            recvFields_[iDim*2+iNeighbor] = new cField3D(n_space);
+        }
     }
 }
 
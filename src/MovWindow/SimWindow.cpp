@@ -36,6 +36,9 @@ SimWindow::SimWindow( Params &params )
     velocity_x = 1.;
     number_of_additional_shifts = 0;
     additional_shifts_time = 0.;
+    particle_creation_threshold_ = 0.;
+    n_deferred_columns_ = 0;
+    n_moved_checked_ = 0;
     
 #ifdef _OPENMP
     max_threads = omp_get_max_threads();
@@ -54,6 +57,11 @@ SimWindow::SimWindow( Params &params )
         PyTools::extract( "velocity_x", velocity_x, "MovingWindow"  );
         PyTools::extract( "number_of_additional_shifts", number_of_additional_shifts, "MovingWindow"  );
         PyTools::extract( "additional_shifts_time", additional_shifts_time, "MovingWindow"  );
+        PyTools::extract( "particle_creation_threshold", particle_creation_threshold_, "MovingWindow"  );
+        if( particle_creation_threshold_ > 0. && params.geometry == "AMcylindrical" ) {
+            ERROR_NAMELIST( "MovingWindow.particle_creation_threshold is not available in AMcylindrical geometry",
+                            LINK_NAMELIST + std::string("#moving-window") );
+        }
     }
     
     cell_length_x_   = params.cell_length[0];
@@ -75,6 +83,9 @@ SimWindow::SimWindow( Params &params )
             MESSAGE( 2, "number_of_additional_shifts : " << number_of_additional_shifts );
             MESSAGE( 2, "additional_shifts_time : " << additional_shifts_time );
         }
+        if( particle_creation_threshold_ > 0. ) {
+            MESSAGE( 2, "particle_creation_threshold : " << particle_creation_threshold_ );
+        }
         params.hasWindow = true;
     } else {
         params.hasWindow = false;
@@ -320,9 +331,9 @@ void SimWindow::shift( VectorPatch &vecPatches, SmileiMPI *smpi, Params &params,
                     // Current newly created patch
                     mypatch = vecPatches.patches_[patch_to_be_created[ithread][j]];
                     
-                    // If new particles are required
+                    // If new particles are required (unless their creation is deferred)
                     if( patch_particle_created[ithread][j] ) {
-                        for( unsigned int ispec=0 ; ispec<nSpecies ; ispec++ ) {
+                        for( unsigned int ispec=0 ; ispec<nSpecies && particle_creation_threshold_ <= 0. ; ispec++ ) {
                             ParticleCreator particle_creator;
                             particle_creator.associate(mypatch->vecSpecies[ispec]);
                             
@@ -470,6 +481,8 @@ void SimWindow::shift( VectorPatch &vecPatches, SmileiMPI *smpi, Params &params,
         {
             x_moved += cell_length_x_*params.n_space[0];
             vecPatches.updateFieldList( smpi ) ;
+            // Patches and MPI neighbours changed: the aggregated messages must be rebuilt
+            vecPatches.invalidateAggregatedMPIbuffers();
             //update list fields for species diag too ??
             
             // Tell that the patches moved this iteration (needed for probes)
@@ -670,3 +683,104 @@ void SimWindow::operate(Region& region,  VectorPatch& vecPatches, SmileiMPI* smp
     //    region.identify_missing_patches( smpi, vecPatches, params );
     //}
 }
+
+// Largest absolute value of a field (0 if not allocated)
+static double maxAbsField( Field *field )
+{
+    double max_abs = 0.;
+    if( field ) {
+        for( unsigned int i=0 ; i<field->globalDims_ ; i++ ) {
+            max_abs = max( max_abs, abs( field->data_[i] ) );
+        }
+    }
+    return max_abs;
+}
+
+void SimWindow::createDeferredParticles( VectorPatch &vecPatches, SmileiMPI *smpi, Params &params )
+{
+    if( particle_creation_threshold_ <= 0. ) {
+        return;
+    }
+
+#ifndef _NO_MPI_TM
+    #pragma omp barrier
+    #pragma omp master
+#endif
+    {
+        // Columns of patches which entered the window since the last check are empty
+        n_deferred_columns_ += ( n_moved - n_moved_checked_ ) / params.n_space[0];
+        n_deferred_columns_ = min( n_deferred_columns_, params.number_of_patches[0] );
+        n_moved_checked_ = n_moved;
+
+        // Fill the first empty column (and the following ones) once it is disturbed
+        while( n_deferred_columns_ > 0 ) {
+            unsigned int column = params.number_of_patches[0] - n_deferred_columns_;
+
+            double local_max = 0.;
+            for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+                Patch *mypatch = vecPatches( ipatch );
+                if( mypatch->Pcoordinates[0] != column ) {
+                    continue;
+                }
+                ElectroMagn *EMfields = mypatch->EMfields;
+                local_max = max( local_max, maxAbsField( EMfields->Ex_ ) );
+                local_max = max( local_max, maxAbsField( EMfields->Ey_ ) );
+                local_max = max( local_max, maxAbsField( EMfields->Ez_ ) );
+                local_max = max( local_max, maxAbsField( EMfields->Bx_ ) );
+                local_max = max( local_max, maxAbsField( EMfields->By_ ) );
+                local_max = max( local_max, maxAbsField( EMfields->Bz_ ) );
+                if( EMfields->envelope ) {
+                    local_max = max( local_max, maxAbsField( EMfields->Env_A_abs_ ) );
+                }
+            }
+            double global_max = 0.;
+            MPI_Allreduce( &local_max, &global_max, 1, MPI_DOUBLE, MPI_MAX, smpi->world() );
+            if( global_max < particle_creation_threshold_ ) {
+                break;
+            }
+
+            for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+                Patch *mypatch = vecPatches( ipatch );
+                if( mypatch->Pcoordinates[0] != column ) {
+                    continue;
+                }
+                for( unsigned int ispec=0 ; ispec<mypatch->vecSpecies.size() ; ispec++ ) {
+                    Species *spec = mypatch->vecSpecies[ispec];
+                    ParticleCreator particle_creator;
+                    particle_creator.associate( spec );
+
+                    struct SubSpace init_space;
+                    init_space.cell_index_[0] = 0;
+                    init_space.cell_index_[1] = 0;
+                    init_space.cell_index_[2] = 0;
+                    init_space.box_size_[0]   = params.n_space[0];
+                    init_space.box_size_[1]   = params.n_space[1];
+                    init_space.box_size_[2]   = params.n_space[2];
+
+                    particle_creator.create( init_space, params, mypatch, 0 );
+
+                    // Same preparation as for patches filled at window entry
+                    if( params.vectorization_mode == "on" ) {
+                        spec->computeParticleCellKeys( params );
+                        spec->sortParticles( params, mypatch );
+                    } else if( params.vectorization_mode == "adaptive_mixed_sort" ) {
+                        spec->configuration( params, mypatch );
+                    } else if( params.vectorization_mode == "adaptive" ) {
+                        spec->computeParticleCellKeys( params );
+                        spec->configuration( params, mypatch );
+                        spec->sortParticles( params, mypatch );
+                    }
+                }
+                for( unsigned int idiag=0; idiag<vecPatches.localDiags.size(); idiag++ ) {
+                    if( DiagnosticTrack *track = dynamic_cast<DiagnosticTrack *>( vecPatches.localDiags[idiag] ) ) {
+                        track->setIDs( mypatch );
+                    }
+                }
+            }
+            n_deferred_columns_--;
+        }
+    }
+#ifndef _NO_MPI_TM
+    #pragma omp barrier
+#endif
+}
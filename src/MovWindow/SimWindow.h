@@ -28,6 +28,10 @@ public:
 
     void shift( VectorPatch &vecPatches, SmileiMPI *smpi, Params &param, unsigned int itime, double time_dual, Region& region );
     
+    //! Fill with particles the columns of patches which entered the window empty,
+    //! once the fields there exceed particle_creation_threshold
+    void createDeferredParticles( VectorPatch &vecPatches, SmileiMPI *smpi, Params &params );
+    
     void operate( Region& region,  VectorPatch& vecPatches, SmileiMPI* smpi, Params& param, double time_dual );
     void operate( Region& region,  VectorPatch& vecPatches, SmileiMPI* smpi, Params& param, double time_dual, unsigned int nmodes );
 
@@ -81,6 +85,18 @@ public:
         return additional_shifts_time;
     }
     
+    //! Return the number of columns of patches still waiting for their particles
+    unsigned int getNumberOfDeferredColumns()
+    {
+        return n_deferred_columns_;
+    }
+    //! Set the number of columns of patches still waiting for their particles (restart case)
+    void setNumberOfDeferredColumns( unsigned int n )
+    {
+        n_deferred_columns_ = n;
+        n_moved_checked_ = n_moved;
+    }
+    
     
 private:
     //! Tells whether there is a moving window or not
@@ -112,6 +128,12 @@ private:
     unsigned int additional_shifts_iteration;
     //! Number of additional moving window shifts
     unsigned int number_of_additional_shifts;
+    //! Field amplitude above which patches entering the window are filled with particles (0 = at entry)
+    double particle_creation_threshold_;
+    //! Number of columns of patches, at the front of the window, not yet filled with particles
+    unsigned int n_deferred_columns_;
+    //! Value of n_moved at the last check of the deferred columns
+    unsigned int n_moved_checked_;
     
     
 };
@@ -12,6 +12,7 @@
 #include "SmileiMPI.h"
 #include "H5.h"
 #include "LaserPropagator.h"
+#include "PartCompTimeCalibration.h"
 
 #include "pyinit.pyh"
 #include "pyprofiles.pyh"
@@ -608,6 +609,15 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
     // cluster_width_
     PyTools::extract( "cluster_width", cluster_width_, "Main"   );
 
+    // cluster_tile_width_
+    PyTools::extract( "cluster_tile_width", cluster_tile_width_, "Main"   );
+    if( cluster_tile_width_ < 0 ) {
+        ERROR_NAMELIST( "The parameter `cluster_tile_width` must be positive or zero", LINK_NAMELIST + std::string("#main-variables") );
+    }
+    if( cluster_tile_width_ > 0 && geometry != "2Dcartesian" && geometry != "3Dcartesian" ) {
+        ERROR_NAMELIST( "The parameter `cluster_tile_width` is only available in 2Dcartesian and 3Dcartesian geometries", LINK_NAMELIST + std::string("#main-variables") );
+    }
+
 
 
     // --------------------
@@ -714,6 +724,9 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
     vectorization_mode = "off";
     has_adaptive_vectorization = false;
     adaptive_vecto_time_selection = nullptr;
+    adaptive_cost_model_file = "";
+    adaptive_cost_model_calibration = false;
+    adaptive_cost_model_calibration_length = 0;
 
     if( PyTools::nComponents( "Vectorization" )>0 ) {
         // Extraction of the vectorization mode
@@ -771,8 +784,79 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
             adaptive_vecto_time_selection = new TimeSelection(
                 PyTools::extract_py( "reconfigure_every", "Vectorization" ), "Adaptive vectorization"
             );
+
+        // Cost model of the adaptive mode measured on this machine
+        PyTools::extract( "cost_model_file", adaptive_cost_model_file, "Vectorization" );
+        if( ! adaptive_cost_model_file.empty() ) {
+            if( ! has_adaptive_vectorization ) {
+                ERROR_NAMELIST( "In block `Vectorization`, `cost_model_file` requires an adaptive `mode`",  LINK_NAMELIST + std::string("#vectorization") );
+            }
+            string content = "";
+            int exists = 0;
+            if( smpi->isMaster() ) {
+                ifstream istr( adaptive_cost_model_file.c_str() );
+                if( istr.is_open() ) {
+                    exists = 1;
+                    std::stringstream buffer;
+                    buffer << istr.rdbuf();
+                    content = buffer.str();
+                }
+            }
+            smpi->bcast( exists );
+            if( exists ) {
+                smpi->bcast( content );
+                if( ! PartCompTimeCalibration::read( content, adaptive_cost_model_vecto_, adaptive_cost_model_scalar_ ) ) {
+                    ERROR_NAMELIST( "In block `Vectorization`, `cost_model_file` " << adaptive_cost_model_file << " is not a valid cost model",  LINK_NAMELIST + std::string("#vectorization") );
+                }
+            } else {
+                // The file will be created at the end of the calibration
+                if( vectorization_mode != "adaptive" ) {
+                    ERROR_NAMELIST( "In block `Vectorization`, the calibration of `cost_model_file` requires `mode = \"adaptive\"`",  LINK_NAMELIST + std::string("#vectorization") );
+                }
+                PyTools::extract( "calibration_reconfigurations", adaptive_cost_model_calibration_length, "Vectorization" );
+                if( adaptive_cost_model_calibration_length < 2 ) {
+                    ERROR_NAMELIST( "In block `Vectorization`, `calibration_reconfigurations` must be at least 2",  LINK_NAMELIST + std::string("#vectorization") );
+                }
+                adaptive_cost_model_calibration = true;
+            }
+        }
     }
     
+    // Online tuning of the load balancing and reconfiguration periods
+    has_autotuning = false;
+    if( PyTools::nComponents( "Autotuning" )>0 ) {
+        PyTools::extract( "window", autotuning_window, "Autotuning" );
+        PyTools::extract( "retune_every", autotuning_retune_every, "Autotuning" );
+        std::vector<std::string> parameters;
+        PyTools::extractV( "parameters", parameters, "Autotuning" );
+        if( autotuning_window < 1 ) {
+            ERROR_NAMELIST( "In block `Autotuning`, `window` must be at least 1",  LINK_NAMELIST + std::string("#autotuning") );
+        }
+        for( unsigned int i=0; i<parameters.size(); i++ ) {
+            if( parameters[i] == "load_balancing" ) {
+                if( ! has_load_balancing ) {
+                    continue;
+                }
+                if( ! load_balancing_time_selection->isRegular() ) {
+                    WARNING( "Autotuning: `LoadBalancing.every` has repeats and will not be tuned" );
+                    continue;
+                }
+            } else if( parameters[i] == "vectorization" ) {
+                if( ! has_adaptive_vectorization ) {
+                    continue;
+                }
+                if( ! adaptive_vecto_time_selection->isRegular() ) {
+                    WARNING( "Autotuning: `Vectorization.reconfigure_every` has repeats and will not be tuned" );
+                    continue;
+                }
+            } else {
+                ERROR_NAMELIST( "In block `Autotuning`, unknown parameter `" << parameters[i] << "` (must be `load_balancing` or `vectorization`)",  LINK_NAMELIST + std::string("#autotuning") );
+            }
+            autotuning_parameters.push_back( parameters[i] );
+        }
+        has_autotuning = autotuning_parameters.size() > 0;
+    }
+
     // Not used, just for compatibility with the GPU branch
     PyTools::extract( "gpu_computing", gpu_computing, "Main"  );
 
@@ -1205,6 +1289,11 @@ void Params::compute()
             LINK_NAMELIST + std::string("#main-variables") );
     }
 
+    // Tiles are only used by the scalar species, vectorized species are already sorted per cell
+    if( cluster_tile_width_ > 0 && vectorization_mode == "on" ) {
+        WARNING( "The parameter `cluster_tile_width` has no effect when vectorization is on" );
+    }
+
     // Define domain decomposition if double grids are used for particles and fields
     if ( multiple_decomposition ) {
         multiple_decompose();
@@ -1372,6 +1461,21 @@ void Params::print_init()
     if( vectorization_mode == "adaptive_mixed_sort" || vectorization_mode == "adaptive" ) {
         MESSAGE( 1, "Default mode: " << adaptive_default_mode );
         MESSAGE( 1, "Time selection: " << adaptive_vecto_time_selection->info() );
+        if( adaptive_cost_model_calibration ) {
+            MESSAGE( 1, "Calibration of the cost model during " << adaptive_cost_model_calibration_length
+                     << " reconfigurations, written in " << adaptive_cost_model_file );
+        } else if( ! adaptive_cost_model_file.empty() ) {
+            MESSAGE( 1, "Cost model read from " << adaptive_cost_model_file );
+        }
+    }
+
+    if( has_autotuning ) {
+        TITLE( "Autotuning: " );
+        for( unsigned int i=0; i<autotuning_parameters.size(); i++ ) {
+            MESSAGE( 1, "Tuned parameter: " << autotuning_parameters[i] );
+        }
+        MESSAGE( 1, "Trial window: " << autotuning_window << " iterations" );
+        MESSAGE( 1, "Retuned every " << autotuning_retune_every << " iterations" );
     }
 
 }
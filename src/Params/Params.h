@@ -186,6 +186,8 @@ public:
     //! Clusters width
     //unsigned int cluster_width_;
     int cluster_width_;
+    //! Width, in cells along Y and Z, of the tiles used to sort particles inside a cluster (0 = no tiling)
+    int cluster_tile_width_;
     //! Number of cells per cluster
     int n_cell_per_patch;
 
@@ -284,6 +286,23 @@ public:
     std::string vectorization_mode;
     //! Initial state of the patches in adaptive mode
     std::string adaptive_default_mode;
+    //! Flag for the online tuning of the performance parameters (Autotuning block)
+    bool has_autotuning;
+    //! Number of iterations of each autotuning trial
+    unsigned int autotuning_window;
+    //! Number of iterations between two autotuning explorations
+    unsigned int autotuning_retune_every;
+    //! Parameters tuned online: "load_balancing" and/or "vectorization"
+    std::vector<std::string> autotuning_parameters;
+    //! File of the adaptive vectorization cost model (read if it exists, calibrated otherwise)
+    std::string adaptive_cost_model_file;
+    //! True when the cost model is being calibrated during this run
+    bool adaptive_cost_model_calibration;
+    //! Number of reconfigurations during which the cost model is calibrated
+    unsigned int adaptive_cost_model_calibration_length;
+    //! Coefficients of the cost model read from `adaptive_cost_model_file`
+    std::vector<double> adaptive_cost_model_vecto_;
+    std::vector<double> adaptive_cost_model_scalar_;
 
     //! Tells whether there is a moving window
     bool hasWindow;
@@ -0,0 +1,45 @@
+#include "PartCompTimeCalibrated.h"
+#include "PartCompTimeCalibration.h"
+
+#include <algorithm>
+#include <cmath>
+
+PartCompTimeCalibrated::PartCompTimeCalibrated( const std::vector<double> &vecto_coefficients, const std::vector<double> &scalar_coefficients )
+    : PartCompTime(),
+      vecto_coefficients_( vecto_coefficients.begin(), vecto_coefficients.end() ),
+      scalar_coefficients_( scalar_coefficients.begin(), scalar_coefficients.end() )
+{
+};
+
+// -----------------------------------------------------------------------------
+//! Evaluate the time (simple precision) to compute all particles
+//! in the current patch with vectorized operators
+//! @param count the numer of particles per cell
+//! @aram vecto_time time in vector mode
+//! @aram scalar_time time in scalar mode
+// -----------------------------------------------------------------------------
+void PartCompTimeCalibrated::operator()(  const std::vector<int> &count,
+                                float &vecto_time,
+                                float &scalar_time  )
+{
+    float vecto_time_loc = 0;
+    float scalar_time_loc = 0;
+    
+    // Loop over the cells
+    for( unsigned int ic=0; ic < count.size(); ic++ ) {
+        if( count[ic] > 0 ) {
+            // Max of the fit
+            float log_particle_number = log( std::min( float( count[ic] ), float( PartCompTimeCalibration::max_particles_per_cell ) ) );
+            float rv = 0, rs = 0, x = 1;
+            for( unsigned int k=0; k < vecto_coefficients_.size(); k++ ) {
+                rv += vecto_coefficients_[k] * x;
+                rs += scalar_coefficients_[k] * x;
+                x *= log_particle_number;
+            }
+            vecto_time_loc += rv*count[ic];
+            scalar_time_loc += rs*count[ic];
+        }
+    }
+    scalar_time = scalar_time_loc;
+    vecto_time = vecto_time_loc;
+};
@@ -0,0 +1,38 @@
+#ifndef PARTCOMPTIMECALIBRATED_H
+#define PARTCOMPTIMECALIBRATED_H
+
+#include "PartCompTime.h"
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class PartCompTimeCalibrated
+//! Particle computation time model fitted on the current machine
+//! (see PartCompTimeCalibration) instead of compiled-in coefficients.
+//! The time per particle in a cell containing n particles is a polynomial of log(n).
+//  --------------------------------------------------------------------------------------------------------------------
+class PartCompTimeCalibrated final : public PartCompTime
+{
+public:
+    PartCompTimeCalibrated( const std::vector<double> &vecto_coefficients, const std::vector<double> &scalar_coefficients );
+    ~PartCompTimeCalibrated() override final {};
+    
+    // -------------------------------------------------------------------------
+    //! Evaluate the time (simple precision) to compute all particles
+    //! in the current patch with vectorized operators
+    //! @param count the numer of particles per cell
+    //! @aram vecto_time time in vector mode
+    //! @aram scalar_time time in scalar mode
+    // -------------------------------------------------------------------------
+    virtual void operator() (   const std::vector<int> &count,
+                        float &vecto_time,
+                        float &scalar_time ) override final;
+    
+private:
+    
+    //! Polynomial coefficients (lowest degree first) of the vectorized mode
+    std::vector<float> vecto_coefficients_;
+    //! Polynomial coefficients (lowest degree first) of the scalar mode
+    std::vector<float> scalar_coefficients_;
+
+};//END class PartCompTimeCalibrated
+
+#endif
@@ -0,0 +1,211 @@
+#include "PartCompTimeCalibration.h"
+
+#include <cmath>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <omp.h>
+
+#include "SmileiMPI.h"
+#include "Tools.h"
+
+const unsigned int PartCompTimeCalibration::degree;
+const int PartCompTimeCalibration::max_particles_per_cell;
+
+PartCompTimeCalibration::PartCompTimeCalibration( std::string file, unsigned int length ) :
+    file_( file ),
+    length_( length ),
+    nreconfigurations_( 0 )
+{
+    unsigned int n = degree + 1;
+    for( unsigned int mode = 0; mode < 2; mode++ ) {
+        normal_equations_[mode].resize( omp_get_max_threads(), std::vector<double>( n*n + n, 0. ) );
+        nsamples_[mode].resize( omp_get_max_threads(), 0 );
+    }
+};
+
+// -----------------------------------------------------------------------------
+//! Add one measurement: the model predicts the time as a linear combination
+//! of the features sum_c count[c] * log(count[c])^k, k = 0..degree
+// -----------------------------------------------------------------------------
+void PartCompTimeCalibration::addSample( bool vectorized, const std::vector<int> &count, double time )
+{
+    unsigned int n = degree + 1;
+    std::vector<double> features( n, 0. );
+    for( unsigned int ic=0; ic < count.size(); ic++ ) {
+        if( count[ic] > 0 ) {
+            double log_particle_number = log( ( double )std::min( count[ic], max_particles_per_cell ) );
+            double x = 1.;
+            for( unsigned int k=0; k < n; k++ ) {
+                features[k] += count[ic] * x;
+                x *= log_particle_number;
+            }
+        }
+    }
+    if( features[0] == 0. ) {
+        return;
+    }
+    
+    // Times are fitted in nanoseconds to keep the system well scaled
+    double t = time * 1e9;
+    int ithread = omp_get_thread_num();
+    std::vector<double> &system = normal_equations_[vectorized][ithread];
+    for( unsigned int i=0; i < n; i++ ) {
+        for( unsigned int j=0; j < n; j++ ) {
+            system[i*n+j] += features[i] * features[j];
+        }
+        system[n*n+i] += features[i] * t;
+    }
+    nsamples_[vectorized][ithread]++;
+};
+
+// -----------------------------------------------------------------------------
+//! Count one reconfiguration: both modes are measured alternately during
+//! the first `length_` reconfigurations only
+// -----------------------------------------------------------------------------
+bool PartCompTimeCalibration::endOfReconfiguration()
+{
+    nreconfigurations_++;
+    return nreconfigurations_ >= length_;
+};
+
+// -----------------------------------------------------------------------------
+//! Gaussian elimination with partial pivoting on the normal equations
+// -----------------------------------------------------------------------------
+bool PartCompTimeCalibration::solve( std::vector<double> &system, std::vector<double> &coefficients )
+{
+    unsigned int n = degree + 1;
+    std::vector<double> a( system.begin(), system.begin() + n*n );
+    std::vector<double> b( system.begin() + n*n, system.end() );
+    
+    // Small regularization relative to the diagonal
+    double trace = 0.;
+    for( unsigned int i=0; i < n; i++ ) {
+        trace += a[i*n+i];
+    }
+    for( unsigned int i=0; i < n; i++ ) {
+        a[i*n+i] += 1e-12 * trace;
+    }
+    
+    for( unsigned int i=0; i < n; i++ ) {
+        unsigned int pivot = i;
+        for( unsigned int r=i+1; r < n; r++ ) {
+            if( std::abs( a[r*n+i] ) > std::abs( a[pivot*n+i] ) ) {
+                pivot = r;
+            }
+        }
+        if( a[pivot*n+i] == 0. ) {
+            return false;
+        }
+        if( pivot != i ) {
+            for( unsigned int c=0; c < n; c++ ) {
+                std::swap( a[i*n+c], a[pivot*n+c] );
+            }
+            std::swap( b[i], b[pivot] );
+        }
+        for( unsigned int r=i+1; r < n; r++ ) {
+            double f = a[r*n+i] / a[i*n+i];
+            for( unsigned int c=i; c < n; c++ ) {
+                a[r*n+c] -= f * a[i*n+c];
+            }
+            b[r] -= f * b[i];
+        }
+    }
+    coefficients.resize( n );
+    for( int i=n-1; i >= 0; i-- ) {
+        double s = b[i];
+        for( unsigned int c=i+1; c < n; c++ ) {
+            s -= a[i*n+c] * coefficients[c];
+        }
+        coefficients[i] = s / a[i*n+i];
+    }
+    return true;
+};
+
+// -----------------------------------------------------------------------------
+//! Fit the models over all threads and MPI processes, and write them in the model file
+// -----------------------------------------------------------------------------
+bool PartCompTimeCalibration::fitAndWrite( SmileiMPI *smpi, std::vector<double> &vecto_coefficients, std::vector<double> &scalar_coefficients )
+{
+    unsigned int n = degree + 1;
+    std::vector<double> coefficients[2];
+    bool success = true;
+    
+    for( unsigned int mode = 0; mode < 2; mode++ ) {
+        // Sum over threads, then over MPI processes
+        std::vector<double> system( n*n + n, 0. );
+        double nsamples = 0.;
+        for( unsigned int ithread=0; ithread < normal_equations_[mode].size(); ithread++ ) {
+            for( unsigned int i=0; i < system.size(); i++ ) {
+                system[i] += normal_equations_[mode][ithread][i];
+            }
+            nsamples += nsamples_[mode][ithread];
+        }
+        MPI_Allreduce( MPI_IN_PLACE, &system[0], system.size(), MPI_DOUBLE, MPI_SUM, smpi->world() );
+        MPI_Allreduce( MPI_IN_PLACE, &nsamples, 1, MPI_DOUBLE, MPI_SUM, smpi->world() );
+        
+        if( nsamples < 10*n ) {
+            WARNING( "Adaptive vectorization calibration: only " << nsamples << " samples for the "
+                     << ( mode ? "vectorized" : "scalar" ) << " operators" );
+            success = false;
+        } else if( ! solve( system, coefficients[mode] ) ) {
+            WARNING( "Adaptive vectorization calibration: unable to fit the "
+                     << ( mode ? "vectorized" : "scalar" ) << " operators" );
+            success = false;
+        }
+    }
+    
+    if( ! success ) {
+        WARNING( "Adaptive vectorization calibration: the cost model file " << file_ << " was not written" );
+        return false;
+    }
+    vecto_coefficients = coefficients[1];
+    scalar_coefficients = coefficients[0];
+    
+    if( smpi->isMaster() ) {
+        std::ofstream f( file_.c_str() );
+        f << "# Smilei adaptive vectorization cost model" << std::endl;
+        f << "# Time per particle (ns) = sum_k c_k log(particles per cell)^k" << std::endl;
+        f << std::setprecision( 10 );
+        f << "vectorized";
+        for( unsigned int k=0; k < n; k++ ) {
+            f << " " << coefficients[1][k];
+        }
+        f << std::endl << "scalar";
+        for( unsigned int k=0; k < n; k++ ) {
+            f << " " << coefficients[0][k];
+        }
+        f << std::endl;
+        MESSAGE( 1, "Adaptive vectorization cost model written in " << file_ );
+    }
+    return true;
+};
+
+// -----------------------------------------------------------------------------
+//! Read the coefficients from the text content of a model file
+// -----------------------------------------------------------------------------
+bool PartCompTimeCalibration::read( std::string content, std::vector<double> &vecto_coefficients, std::vector<double> &scalar_coefficients )
+{
+    std::istringstream lines( content );
+    std::string line;
+    vecto_coefficients.resize( 0 );
+    scalar_coefficients.resize( 0 );
+    while( std::getline( lines, line ) ) {
+        if( line.empty() || line[0] == '#' ) {
+            continue;
+        }
+        std::istringstream words( line );
+        std::string mode;
+        words >> mode;
+        std::vector<double> &coefficients = ( mode == "vectorized" ) ? vecto_coefficients : scalar_coefficients;
+        if( mode != "vectorized" && mode != "scalar" ) {
+            return false;
+        }
+        double c;
+        while( words >> c ) {
+            coefficients.push_back( c );
+        }
+    }
+    return vecto_coefficients.size() == degree + 1 && scalar_coefficients.size() == degree + 1;
+};
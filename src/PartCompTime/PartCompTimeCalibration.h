@@ -0,0 +1,58 @@
+#ifndef PARTCOMPTIMECALIBRATION_H
+#define PARTCOMPTIMECALIBRATION_H
+
+#include <vector>
+#include <string>
+
+class SmileiMPI;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class PartCompTimeCalibration
+//! Collects the measured times of the species dynamics in adaptive vectorization mode
+//! and fits, for the scalar and vectorized operators, the time per particle
+//! as a polynomial of log(number of particles per cell), by linear least squares.
+//  --------------------------------------------------------------------------------------------------------------------
+class PartCompTimeCalibration
+{
+public:
+    PartCompTimeCalibration( std::string file, unsigned int length );
+    ~PartCompTimeCalibration() {};
+    
+    //! Degree of the fitted polynomial
+    static const unsigned int degree = 4;
+    //! Number of particles per cell above which the fit is constant
+    static const int max_particles_per_cell = 256;
+    
+    //! Add one measurement: time spent to compute the particles distributed in cells as `count`
+    void addSample( bool vectorized, const std::vector<int> &count, double time );
+    
+    //! Count one reconfiguration, returns true when the calibration is over
+    bool endOfReconfiguration();
+    
+    //! Fit the models over all threads and MPI processes, and write them in the model file (MPI master only)
+    //! Returns false if the fit failed
+    bool fitAndWrite( SmileiMPI *smpi, std::vector<double> &vecto_coefficients, std::vector<double> &scalar_coefficients );
+    
+    //! Read the coefficients from the text `content` of a model file
+    static bool read( std::string content, std::vector<double> &vecto_coefficients, std::vector<double> &scalar_coefficients );
+    
+private:
+    
+    //! Path of the cost model file written at the end of the run
+    std::string file_;
+    
+    //! Number of reconfigurations of the calibration, and number done so far
+    unsigned int length_;
+    unsigned int nreconfigurations_;
+    
+    //! Normal equations (matrix then right-hand side) for each thread and mode (0 = scalar, 1 = vectorized)
+    std::vector<std::vector<double> > normal_equations_[2];
+    //! Number of samples for each thread and mode
+    std::vector<unsigned int> nsamples_[2];
+    
+    //! Solve the normal equations in place (Gaussian elimination), returns false if singular
+    static bool solve( std::vector<double> &system, std::vector<double> &coefficients );
+
+};//END class PartCompTimeCalibration
+
+#endif
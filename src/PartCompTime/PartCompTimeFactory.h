@@ -7,6 +7,7 @@
 #include "PartCompTime3D2Order.h"
 #include "PartCompTime3D4Order.h"
 #include "PartCompTimeAM2Order.h"
+#include "PartCompTimeCalibrated.h"
 
 #include "Params.h"
 #include "Tools.h"
@@ -18,6 +19,12 @@ public:
     {
         
         PartCompTime * part_comp_time = NULL;
+        
+        // Cost model measured on this machine (Vectorization.cost_model_file)
+        if( ! params.adaptive_cost_model_vecto_.empty() ) {
+            return new PartCompTimeCalibrated( params.adaptive_cost_model_vecto_, params.adaptive_cost_model_scalar_ );
+        }
+        
         // ---------------
         // 1Dcartesian simulation
         // ---------------
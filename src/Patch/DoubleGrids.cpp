@@ -49,18 +49,33 @@ void DoubleGrids::syncCurrentsOnRegion( VectorPatch &vecPatches, Region &region,
     }
 
     // Loop / local_patches_ ( patches own by the local vePatches whose data are used by the local Region )
-    for ( unsigned int i=0 ; i<region.local_patches_.size() ; i++ ) {
-
-        unsigned int ipatch = region.local_patches_[i]-vecPatches.refHindex_;
-        vecPatches(ipatch)->EMfields->Jx_->add( region.patch_->EMfields->Jx_, params, smpi, vecPatches(ipatch), region.patch_ );
-        vecPatches(ipatch)->EMfields->Jy_->add( region.patch_->EMfields->Jy_, params, smpi, vecPatches(ipatch), region.patch_ );
-        vecPatches(ipatch)->EMfields->Jz_->add( region.patch_->EMfields->Jz_, params, smpi, vecPatches(ipatch), region.patch_ );
-
-	if(params.is_spectral){
-            vecPatches(ipatch)->EMfields->rho_->add( region.patch_->EMfields->rho_, params, smpi, vecPatches(ipatch), region.patch_ );
-            // rho_old is save directly on the Region after the resolution of the Maxwell solver
-	}
-
+    //        Patches overlap in the Region through their ghost cells, they are added by colors :
+    //        2 patches of the same color are at least 2 patches apart in one direction, and a patch
+    //        is at least 2*oversize+2 cells long, so that a color can be added by all threads at once
+    unsigned int ncolors = 1 << params.nDim_field;
+    for ( unsigned int icolor=0 ; icolor<ncolors ; icolor++ ) {
+        #pragma omp parallel for schedule(dynamic)
+        for ( unsigned int i=0 ; i<region.local_patches_.size() ; i++ ) {
+
+            unsigned int ipatch = region.local_patches_[i]-vecPatches.refHindex_;
+            unsigned int color = 0;
+            for ( unsigned int iDim=0 ; iDim<params.nDim_field ; iDim++ ) {
+                color |= ( vecPatches(ipatch)->Pcoordinates[iDim]%2 ) << iDim;
+            }
+            if( color != icolor ) {
+                continue;
+            }
+
+            vecPatches(ipatch)->EMfields->Jx_->add( region.patch_->EMfields->Jx_, params, smpi, vecPatches(ipatch), region.patch_ );
+            vecPatches(ipatch)->EMfields->Jy_->add( region.patch_->EMfields->Jy_, params, smpi, vecPatches(ipatch), region.patch_ );
+            vecPatches(ipatch)->EMfields->Jz_->add( region.patch_->EMfields->Jz_, params, smpi, vecPatches(ipatch), region.patch_ );
+
+            if(params.is_spectral){
+                vecPatches(ipatch)->EMfields->rho_->add( region.patch_->EMfields->rho_, params, smpi, vecPatches(ipatch), region.patch_ );
+                // rho_old is save directly on the Region after the resolution of the Maxwell solver
+            }
+
+        }
     }
     timers.grids.update();
 }
@@ -154,6 +169,8 @@ void DoubleGrids::syncFieldsOnPatches( Region &region, VectorPatch &vecPatches,
     }
 
     // Loop / local_patches_ ( patches own by the local vePatches whose data are used by the local Region )
+    //        Each patch only receives its own data : no conflict between threads
+    #pragma omp parallel for schedule(dynamic)
     for ( unsigned int i=0 ; i<region.local_patches_.size() ; i++ ) {
 
         unsigned int ipatch = region.local_patches_[i]-vecPatches.refHindex_;
@@ -404,6 +421,8 @@ void DoubleGrids::syncBOnPatches( Region &region, VectorPatch &vecPatches, Param
     }
 
     // Loop / local_patches_ ( patches own by the local vePatches whose data are used by the local Region )
+    //        Each patch only receives its own data : no conflict between threads
+    #pragma omp parallel for schedule(dynamic)
     for ( unsigned int i=0 ; i<region.local_patches_.size() ; i++ ) {
 
         unsigned int ipatch = region.local_patches_[i]-vecPatches.refHindex_;
@@ -495,6 +514,8 @@ void DoubleGrids::syncCurrentsOnPatches( Region &region, VectorPatch &vecPatches
     }
 
     // Loop / local_patches_ ( patches own by the local vePatches whose data are used by the local Region )
+    //        Each patch only receives its own data : no conflict between threads
+    #pragma omp parallel for schedule(dynamic)
     for ( unsigned int i=0 ; i<region.local_patches_.size() ; i++ ) {
 
         unsigned int ipatch = region.local_patches_[i]-vecPatches.refHindex_;
@@ -31,6 +31,7 @@ class Patch
     friend class SimWindow;
     friend class SyncVectorPatch;
     friend class AsyncMPIbuffers;
+    friend class AggregatedMPIbuffers;
 public:
     //! Constructor for Patch
     Patch( Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decomposition, unsigned int ipatch, unsigned int n_moved );
@@ -140,6 +141,11 @@ public:
     //! finalize comm / exchange fields
     virtual void finalizeExchange( Field *field, int iDim );
     
+    //! init comm / sum densities of all azimuthal modes of a field in a single message per neighbor
+    virtual void initSumFieldAllModes( std::vector<Field *> &modes, int iDim, SmileiMPI *smpi ) {};
+    //! init comm / exchange all azimuthal modes of a field in a single message per neighbor
+    virtual void initExchangeAllModes( std::vector<Field *> &modes, int iDim, SmileiMPI *smpi ) {};
+    
     virtual void exchangeField_movewin ( Field* field, int clrw ) = 0;
     
     // Create MPI_Datatype to exchange fields
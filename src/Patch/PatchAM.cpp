@@ -175,6 +175,124 @@ void PatchAM::initSumFieldComplex( Field *field, int iDim, SmileiMPI *smpi )
     
 } // END initSumFieldComplex
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Initialize current patch sum Fields communications through MPI in direction iDim for all modes of a field
+// All modes travel in a single message per neighbor, requests and tags are those of mode 0
+// ---------------------------------------------------------------------------------------------------------------------
+void PatchAM::initSumFieldAllModes( std::vector<Field *> &modes, int iDim, SmileiMPI *smpi )
+{
+    Field *field = modes[0];
+    if( field->MPIbuff.srequest.size()==0 ) {
+        field->MPIbuff.allocate( nDim_fields_ );
+        
+        int tagp( 0 );
+        if( field->name == "Jl" ) {
+            tagp = 1;
+        }
+        if( field->name == "Jr" ) {
+            tagp = 2;
+        }
+        if( field->name == "Jt" ) {
+            tagp = 3;
+        }
+        if( field->name == "Rho" ) {
+            tagp = 4;
+        }
+        
+        field->MPIbuff.defineTags( this, smpi, tagp );
+    }
+    
+    int patch_nbNeighbors_( 2 );
+    
+    for( int iNeighbor=0 ; iNeighbor<patch_nbNeighbors_ ; iNeighbor++ ) {
+    
+        if( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+            int tag = field->MPIbuff.send_tags_[iDim][iNeighbor];
+            MPI_Datatype type = createModesType( modes, iDim*2+iNeighbor, true );
+            MPI_Isend( MPI_BOTTOM, 1, type, MPI_neighbor_[iDim][iNeighbor], tag,
+                       MPI_COMM_WORLD, &( field->MPIbuff.srequest[iDim][iNeighbor] ) );
+            MPI_Type_free( &type );
+        } // END of Send
+        
+        if( is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
+            int tag = field->MPIbuff.recv_tags_[iDim][iNeighbor];
+            MPI_Datatype type = createModesType( modes, iDim*2+(iNeighbor+1)%2, false );
+            MPI_Irecv( MPI_BOTTOM, 1, type, MPI_neighbor_[iDim][( iNeighbor+1 )%2], tag,
+                       MPI_COMM_WORLD, &( field->MPIbuff.rrequest[iDim][( iNeighbor+1 )%2] ) );
+            MPI_Type_free( &type );
+        } // END of Recv
+        
+    } // END for iNeighbor
+    
+} // END initSumFieldAllModes
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Initialize current patch exchange Fields communications through MPI in direction iDim for all modes of a field
+// All modes travel in a single message per neighbor, requests and tags are those of mode 0
+// ---------------------------------------------------------------------------------------------------------------------
+void PatchAM::initExchangeAllModes( std::vector<Field *> &modes, int iDim, SmileiMPI *smpi )
+{
+    Field *field = modes[0];
+    if( field->MPIbuff.srequest.size()==0 ) {
+        field->MPIbuff.allocate( nDim_fields_ );
+        
+        int tagp( 0 );
+        if( field->name == "Bl" ) {
+            tagp = 6;
+        }
+        if( field->name == "Br" ) {
+            tagp = 7;
+        }
+        if( field->name == "Bt" ) {
+            tagp = 8;
+        }
+        
+        field->MPIbuff.defineTags( this, smpi, tagp );
+    }
+    
+    for( int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++ ) {
+    
+        if( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+            int tag = field->MPIbuff.send_tags_[iDim][iNeighbor];
+            MPI_Datatype type = createModesType( modes, iDim*2+iNeighbor, true );
+            MPI_Isend( MPI_BOTTOM, 1, type, MPI_neighbor_[iDim][iNeighbor], tag,
+                       MPI_COMM_WORLD, &( field->MPIbuff.srequest[iDim][iNeighbor] ) );
+            MPI_Type_free( &type );
+        } // END of Send
+        
+        if( is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
+            int tag = field->MPIbuff.recv_tags_[iDim][iNeighbor];
+            MPI_Datatype type = createModesType( modes, iDim*2+(iNeighbor+1)%2, false );
+            MPI_Irecv( MPI_BOTTOM, 1, type, MPI_neighbor_[iDim][( iNeighbor+1 )%2], tag,
+                       MPI_COMM_WORLD, &( field->MPIbuff.rrequest[iDim][( iNeighbor+1 )%2] ) );
+            MPI_Type_free( &type );
+        } // END of Recv
+        
+    } // END for iNeighbor
+    
+} // END initExchangeAllModes
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Create the MPI_Datatype which gathers the send (or recv) buffer iBuffer of all modes
+// Sub-fields may be reallocated by create_sub_fields, so the type is built for each communication
+// ---------------------------------------------------------------------------------------------------------------------
+MPI_Datatype PatchAM::createModesType( std::vector<Field *> &modes, int iBuffer, bool send )
+{
+    int nmodes = modes.size();
+    std::vector<int> blocklengths( nmodes );
+    std::vector<MPI_Aint> displacements( nmodes );
+    for( int imode=0 ; imode<nmodes ; imode++ ) {
+        cField *buffer = static_cast<cField *>( send ? modes[imode]->sendFields_[iBuffer] : modes[imode]->recvFields_[iBuffer] );
+        blocklengths[imode] = 2*buffer->globalDims_;
+        MPI_Get_address( buffer->cdata_, &( displacements[imode] ) );
+    }
+    
+    MPI_Datatype type;
+    MPI_Type_create_hindexed( nmodes, &( blocklengths[0] ), &( displacements[0] ), MPI_DOUBLE, &type );
+    MPI_Type_commit( &type );
+    return type;
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Create MPI_Datatypes used in initSumField and initExchange
 // ---------------------------------------------------------------------------------------------------------------------
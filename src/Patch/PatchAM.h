@@ -49,6 +49,13 @@ public:
     
     //! init comm / sum densities
     void initSumFieldComplex( Field *field, int iDim, SmileiMPI *smpi ) override final;
+    //! init comm / sum densities, all modes packed in one message
+    void initSumFieldAllModes( std::vector<Field *> &modes, int iDim, SmileiMPI *smpi ) override final;
+    //! init comm / exchange fields, all modes packed in one message
+    void initExchangeAllModes( std::vector<Field *> &modes, int iDim, SmileiMPI *smpi ) override final;
+    
+    //! MPI_Datatype gathering the sub-field iBuffer of all modes (absolute addresses, used with MPI_BOTTOM)
+    MPI_Datatype createModesType( std::vector<Field *> &modes, int iBuffer, bool send );
     
     void exchangeField_movewin( Field* field, int clrw ) override final;
     
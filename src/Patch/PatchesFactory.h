@@ -74,14 +74,66 @@ public:
         TITLE( "Initializing Patches" );
         MESSAGE( 1, "First patch created" );
         
-        // If normal mode (not test mode) clone the first patch to create the others
-        unsigned int percent=10;
-        for( unsigned int ipatch = 1 ; ipatch < npatches ; ipatch++ ) {
-            if( ( 100*ipatch )/npatches > percent ) {
-                MESSAGE( 2, "Approximately "<<percent<<"% of patches created" );
-                percent += 10;
+        // If normal mode (not test mode) clone the first patch to create the others.
+        // Each thread clones the patches it owns under the static schedule so that
+        // their fields are first touched (and placed in memory) by that thread.
+        // This only fixes memory placement: the clone itself stays serialized, as in
+        // SimWindow::shift, because python profiles are copied or evaluated all along
+        // the Patch, Species, Laser and injector copy constructors.
+        // Particles, which may require python profiles, are created afterwards
+        // by the master thread only.
+        #pragma omp parallel
+        {
+            #pragma omp for schedule(static)
+            for( unsigned int ipatch = 0 ; ipatch < npatches ; ipatch++ ) {
+                if( ipatch == 0 ) {
+                    continue;
+                }
+                Patch *mypatch;
+                #pragma omp critical
+                mypatch = clone( vecPatches( 0 ), params, smpi, vecPatches.domain_decomposition_, firstpatch + ipatch, n_moved, false );
+                vecPatches.patches_[ipatch] = mypatch;
+            }
+            
+            #pragma omp master
+            {
+                MESSAGE( 2, "All patches cloned" );
+                if( ! params.restart ) {
+                    unsigned int percent=10;
+                    for( unsigned int ipatch = 1 ; ipatch < npatches ; ipatch++ ) {
+                        if( ( 100*ipatch )/npatches > percent ) {
+                            MESSAGE( 2, "Approximately "<<percent<<"% of patches filled with particles" );
+                            percent += 10;
+                        }
+                        Patch *mypatch = vecPatches.patches_[ipatch];
+                        for( unsigned int ispec=0 ; ispec<mypatch->vecSpecies.size() ; ispec++ ) {
+                            struct SubSpace init_space;
+                            init_space.cell_index_[0] = 0;
+                            init_space.cell_index_[1] = 0;
+                            init_space.cell_index_[2] = 0;
+                            init_space.box_size_[0]   = params.n_space[0];
+                            init_space.box_size_[1]   = params.n_space[1];
+                            init_space.box_size_[2]   = params.n_space[2];
+                            
+                            ParticleCreator particle_creator;
+                            particle_creator.associate( mypatch->vecSpecies[ispec] );
+                            particle_creator.create( init_space, params, mypatch, 0 );
+                        }
+                    }
+                }
+            }
+            #pragma omp barrier
+            
+            // Copy the particles created by the master thread into memory
+            // first touched by the thread owning the patch
+            if( ! params.restart ) {
+                #pragma omp for schedule(static)
+                for( unsigned int ipatch = 0 ; ipatch < npatches ; ipatch++ ) {
+                    for( unsigned int ispec=0 ; ispec<vecPatches( ipatch )->vecSpecies.size() ; ispec++ ) {
+                        vecPatches( ipatch )->vecSpecies[ispec]->particles->shrinkToFit();
+                    }
+                }
             }
-            vecPatches.patches_[ipatch] = clone( vecPatches( 0 ), params, smpi, vecPatches.domain_decomposition_, firstpatch + ipatch, n_moved );
         }
         
         // Clean numpy/HDF5 arrays for particle initialization
@@ -224,6 +224,138 @@ void SyncVectorPatch::sumRhoJs( Params &params, VectorPatch &vecPatches, int imo
     }
 }
 
+//sumRhoJ for AM geometry, all modes of a component are summed through a single message
+void SyncVectorPatch::sumRhoJAllModes( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi, Timers &timers, int itime )
+{
+    SyncVectorPatch::sumAllModes( vecPatches.listJl_, vecPatches, smpi, timers, itime );
+    SyncVectorPatch::sumAllModes( vecPatches.listJr_, vecPatches, smpi, timers, itime );
+    SyncVectorPatch::sumAllModes( vecPatches.listJt_, vecPatches, smpi, timers, itime );
+    if( ( vecPatches.diag_flag ) || ( params.is_spectral ) ) {
+        SyncVectorPatch::sumAllModes( vecPatches.listrho_AM_, vecPatches, smpi, timers, itime );
+        if (params.is_spectral)
+            SyncVectorPatch::sumAllModes( vecPatches.listrho_old_AM_, vecPatches, smpi, timers, itime );
+    }
+}
+
+void SyncVectorPatch::sumRhoJsAllModes( Params &params, VectorPatch &vecPatches, int ispec, SmileiMPI *smpi, Timers &timers, int itime )
+{
+    // Sum Jl_s(ispec), Jr_s(ispec) and Jt_s(ispec)
+    if( vecPatches.listJls_[0].size()>0 ) {
+        SyncVectorPatch::sumAllModes( vecPatches.listJls_, vecPatches, smpi, timers, itime );
+    }
+    if( vecPatches.listJrs_[0].size()>0 ) {
+        SyncVectorPatch::sumAllModes( vecPatches.listJrs_, vecPatches, smpi, timers, itime );
+    }
+    if( vecPatches.listJts_[0].size()>0 ) {
+        SyncVectorPatch::sumAllModes( vecPatches.listJts_, vecPatches, smpi, timers, itime );
+    }
+    // Sum rho_s(ispec)
+    if( vecPatches.listrhos_AM_[0].size()>0 ) {
+        SyncVectorPatch::sumAllModes( vecPatches.listrhos_AM_, vecPatches, smpi, timers, itime );
+    }
+}
+
+// fields[imode] : contains a single complex field component for all patches of vecPatches
+//     - same algorithm as sum<complex<double>,cField> in 2D
+//     - the MPI part is done once for all modes : 1 message per patch, direction and neighbor
+void SyncVectorPatch::sumAllModes( std::vector<std::vector<Field *>> &fields, VectorPatch &vecPatches, SmileiMPI *smpi, Timers &timers, int itime )
+{
+    unsigned int nx_, ny_, h0, oversize[2], n_space[2], gsp[2];
+    complex<double> *pt1, *pt2;
+    cField *field1;
+    cField *field2;
+    h0 = vecPatches( 0 )->hindex;
+
+    unsigned int nPatches( vecPatches.size() );
+    unsigned int nmodes( fields.size() );
+
+    oversize[0] = vecPatches( 0 )->EMfields->oversize[0];
+    oversize[1] = vecPatches( 0 )->EMfields->oversize[1];
+
+    n_space[0] = vecPatches( 0 )->EMfields->n_space[0];
+    n_space[1] = vecPatches( 0 )->EMfields->n_space[1];
+
+    nx_ = fields[0][0]->dims_[0];
+    ny_ = fields[0][0]->dims_[1];
+    gsp[0] = 1+2*oversize[0]+fields[0][0]->isDual_[0]; //Ghost size primal
+    gsp[1] = 1+2*oversize[1]+fields[0][0]->isDual_[1]; //Ghost size primal
+
+    for( unsigned int iDim=0 ; iDim<2 ; iDim++ ) {
+
+        // initialize comms : Isend/Irecv
+    #ifndef _NO_MPI_TM
+        #pragma omp for schedule(static)
+    #else
+        #pragma omp single
+    #endif
+        for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
+            std::vector<Field *> modes( nmodes );
+            for( unsigned int imode=0 ; imode<nmodes ; imode++ ) {
+                modes[imode] = fields[imode][ipatch];
+                for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
+                    if ( vecPatches( ipatch )->is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+                        modes[imode]->create_sub_fields ( iDim, iNeighbor, 2*oversize[iDim]+1+modes[imode]->isDual_[iDim] );
+                        modes[imode]->extract_fields_sum( iDim, iNeighbor, oversize[iDim] );
+                    }
+                }
+            }
+            vecPatches( ipatch )->initSumFieldAllModes( modes, iDim, smpi );
+        }
+
+        // local
+        #pragma omp for schedule(static) private(pt1,pt2)
+        for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
+            if( vecPatches( ipatch )->MPI_me_ == vecPatches( ipatch )->MPI_neighbor_[iDim][0] ) {
+                //The patch to the west (iDim=0) or to the south (iDim=1) belongs to the same MPI process than I.
+                for( unsigned int imode=0 ; imode<nmodes ; imode++ ) {
+                    field1 = static_cast<cField *>( fields[imode][vecPatches( ipatch )->neighbor_[iDim][0]-h0] );
+                    field2 = static_cast<cField *>( fields[imode][ipatch] );
+                    if( iDim==0 ) {
+                        pt1 = &( *field1 )( n_space[0]*ny_ );
+                        pt2 = &( *field2 )( 0 );
+                        //Sum 2 ==> 1
+                        for( unsigned int i = 0; i < gsp[0]*ny_ ; i++ ) {
+                            pt1[i] += pt2[i];
+                        }
+                        //Copy back the results to 2
+                        memcpy( pt2, pt1, gsp[0]*ny_*sizeof( complex<double> ) );
+                    } else {
+                        pt1 = &( *field1 )( n_space[1] );
+                        pt2 = &( *field2 )( 0 );
+                        for( unsigned int j = 0; j < nx_ ; j++ ) {
+                            for( unsigned int i = 0; i < gsp[1] ; i++ ) {
+                                pt1[i] += pt2[i];
+                            }
+                            memcpy( pt2, pt1, gsp[1]*sizeof( complex<double> ) );
+                            pt1 += ny_;
+                            pt2 += ny_;
+                        }
+                    }
+                }
+            }
+        }
+
+        // finalize (waitall)
+    #ifndef _NO_MPI_TM
+        #pragma omp for schedule(static)
+    #else
+        #pragma omp single
+    #endif
+        for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
+            vecPatches( ipatch )->finalizeSumField( fields[0][ipatch], iDim );
+            for( unsigned int imode=0 ; imode<nmodes ; imode++ ) {
+                for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
+                    if ( vecPatches( ipatch )->is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
+                        fields[imode][ipatch]->inject_fields_sum( iDim, iNeighbor, oversize[iDim] );
+                    }
+                }
+            }
+        }
+
+    } // End for iDim
+
+}
+
 // The idea is to minimize the number of implicit barriers and maximize the workload between barriers
 // fields : contains all (Jx then Jy then Jz) components of a field for all patches of vecPatches
 //     - fields is not directly used in the exchange process, just to find local neighbor's field
@@ -666,6 +798,26 @@ void SyncVectorPatch::exchangeE( Params &params, VectorPatch &vecPatches, int im
     SyncVectorPatch::finalizeExchangeAlongAllDirections( vecPatches.listEt_[imode], vecPatches );
 }
 
+void SyncVectorPatch::exchangeBAllModes( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi )
+{
+    SyncVectorPatch::exchangeAllModesAlongAllDirections( vecPatches.listBl_, vecPatches, smpi );
+    SyncVectorPatch::finalizeExchangeAllModesAlongAllDirections( vecPatches.listBl_, vecPatches );
+    SyncVectorPatch::exchangeAllModesAlongAllDirections( vecPatches.listBr_, vecPatches, smpi );
+    SyncVectorPatch::finalizeExchangeAllModesAlongAllDirections( vecPatches.listBr_, vecPatches );
+    SyncVectorPatch::exchangeAllModesAlongAllDirections( vecPatches.listBt_, vecPatches, smpi );
+    SyncVectorPatch::finalizeExchangeAllModesAlongAllDirections( vecPatches.listBt_, vecPatches );
+}
+
+void SyncVectorPatch::exchangeEAllModes( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi )
+{
+    SyncVectorPatch::exchangeAllModesAlongAllDirections( vecPatches.listEl_, vecPatches, smpi );
+    SyncVectorPatch::finalizeExchangeAllModesAlongAllDirections( vecPatches.listEl_, vecPatches );
+    SyncVectorPatch::exchangeAllModesAlongAllDirections( vecPatches.listEr_, vecPatches, smpi );
+    SyncVectorPatch::finalizeExchangeAllModesAlongAllDirections( vecPatches.listEr_, vecPatches );
+    SyncVectorPatch::exchangeAllModesAlongAllDirections( vecPatches.listEt_, vecPatches, smpi );
+    SyncVectorPatch::finalizeExchangeAllModesAlongAllDirections( vecPatches.listEt_, vecPatches );
+}
+
 void SyncVectorPatch::finalizeexchangeB( Params &params, VectorPatch &vecPatches, int imode )
 {
 }
@@ -963,6 +1115,117 @@ void SyncVectorPatch::finalizeExchangeAlongAllDirections( std::vector<Field *> f
 }
 
 
+// fields[imode] : contains a single complex field component for all patches of vecPatches (AM geometry)
+//     - same algorithm as exchangeAlongAllDirections<complex<double>,cField> in 2D
+//     - the MPI part is done once for all modes : 1 message per patch, direction and neighbor
+void SyncVectorPatch::exchangeAllModesAlongAllDirections( std::vector<std::vector<Field *>> &fields, VectorPatch &vecPatches, SmileiMPI *smpi )
+{
+    unsigned int oversize[2];
+    oversize[0] = vecPatches( 0 )->EMfields->oversize[0];
+    oversize[1] = vecPatches( 0 )->EMfields->oversize[1];
+
+    unsigned int nPatches( vecPatches.size() );
+    unsigned int nmodes( fields.size() );
+
+    for( unsigned int iDim=0 ; iDim<2 ; iDim++ ) {
+#ifndef _NO_MPI_TM
+        #pragma omp for schedule(static)
+#else
+        #pragma omp single
+#endif
+        for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
+            std::vector<Field *> modes( nmodes );
+            for( unsigned int imode=0 ; imode<nmodes ; imode++ ) {
+                modes[imode] = fields[imode][ipatch];
+                for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
+                    if ( vecPatches( ipatch )->is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+                        modes[imode]->create_sub_fields  ( iDim, iNeighbor, oversize[iDim] );
+                        modes[imode]->extract_fields_exch( iDim, iNeighbor, oversize[iDim] );
+                    }
+                }
+            }
+            vecPatches( ipatch )->initExchangeAllModes( modes, iDim, smpi );
+        }
+    } // End for iDim
+
+    unsigned int nx_, ny_, h0, n_space[2], gsp[2];
+    complex<double> *pt1, *pt2;
+    cField *field1, *field2;
+    h0 = vecPatches( 0 )->hindex;
+
+    n_space[0] = vecPatches( 0 )->EMfields->n_space[0];
+    n_space[1] = vecPatches( 0 )->EMfields->n_space[1];
+
+    nx_ = fields[0][0]->dims_[0];
+    ny_ = fields[0][0]->dims_[1];
+
+    gsp[0] = ( oversize[0] + 1 + fields[0][0]->isDual_[0] ); //Ghost size primal
+    gsp[1] = ( oversize[1] + 1 + fields[0][0]->isDual_[1] ); //Ghost size primal
+
+    #pragma omp for schedule(static) private(pt1,pt2)
+    for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
+        for( unsigned int imode=0 ; imode<nmodes ; imode++ ) {
+
+            if( vecPatches( ipatch )->MPI_me_ == vecPatches( ipatch )->MPI_neighbor_[0][0] ) {
+                field1 = static_cast<cField *>( fields[imode][vecPatches( ipatch )->neighbor_[0][0]-h0] );
+                field2 = static_cast<cField *>( fields[imode][ipatch] );
+                pt1 = &( *field1 )( ( n_space[0] )*ny_ );
+                pt2 = &( *field2 )( 0 );
+                memcpy( pt2, pt1, oversize[0]*ny_*sizeof( complex<double> ) );
+                memcpy( pt1+gsp[0]*ny_, pt2+gsp[0]*ny_, oversize[0]*ny_*sizeof( complex<double> ) );
+            } // End if ( MPI_me_ == MPI_neighbor_[0][0] )
+
+            if( vecPatches( ipatch )->MPI_me_ == vecPatches( ipatch )->MPI_neighbor_[1][0] ) {
+                field1 = static_cast<cField *>( fields[imode][vecPatches( ipatch )->neighbor_[1][0]-h0] );
+                field2 = static_cast<cField *>( fields[imode][ipatch] );
+                pt1 = &( *field1 )( n_space[1] );
+                pt2 = &( *field2 )( 0 );
+                for( unsigned int i = 0 ; i < nx_*ny_ ; i += ny_ ) {
+                    for( unsigned int j = 0 ; j < oversize[1] ; j++ ) {
+                        pt2[i+j] = pt1[i+j] ;
+                        pt1[i+j+gsp[1]] = pt2[i+j+gsp[1]] ;
+                    }
+                }
+            } // End if ( MPI_me_ == MPI_neighbor_[1][0] )
+
+        } // End for( imode )
+    } // End for( ipatch )
+
+}
+
+// MPI_Wait for all communications initialised in exchangeAllModesAlongAllDirections
+void SyncVectorPatch::finalizeExchangeAllModesAlongAllDirections( std::vector<std::vector<Field *>> &fields, VectorPatch &vecPatches )
+{
+    unsigned oversize[2];
+    oversize[0] = vecPatches( 0 )->EMfields->oversize[0];
+    oversize[1] = vecPatches( 0 )->EMfields->oversize[1];
+
+    unsigned int nPatches( vecPatches.size() );
+    unsigned int nmodes( fields.size() );
+
+    for( unsigned int iDim=0 ; iDim<2 ; iDim++ ) {
+#ifndef _NO_MPI_TM
+        #pragma omp for schedule(static)
+#else
+        #pragma omp single
+#endif
+        for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
+            // Requests of all modes are stored in mode 0
+            vecPatches( ipatch )->finalizeExchange( fields[0][ipatch], iDim );
+
+            for( unsigned int imode=0 ; imode<nmodes ; imode++ ) {
+                for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
+                    if ( vecPatches( ipatch )->is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
+                        fields[imode][ipatch]->inject_fields_exch( iDim, iNeighbor, oversize[iDim] );
+                    }
+                }
+            }
+        }
+    } // End for iDim
+
+}
+
+
 // fields : contains a single field component (X, Y or Z) for all patches of vecPatches
 // timers and itime were here introduced for debugging
 template<typename T, typename F>
@@ -1315,10 +1578,12 @@ void SyncVectorPatch::exchangeAllComponentsAlongX( std::vector<Field *> &fields,
                 vecPatches.B_MPIx[ifield+nMPIx]->extract_fields_exch( 0, iNeighbor, oversize );
             }
         }
-        vecPatches( ipatch )->initExchange( vecPatches.B_MPIx[ifield      ], 0, smpi ); // By
-        vecPatches( ipatch )->initExchange( vecPatches.B_MPIx[ifield+nMPIx], 0, smpi ); // Bz
     }
 
+    // One message per side and neighbour MPI process for all patches and both components
+    #pragma omp single
+    vecPatches.B_MPI_aggregated[0].start( vecPatches.B_MPIx, vecPatches.MPIxIdx, 2, 0, vecPatches, smpi );
+
     unsigned int h0, n_space;
     double *pt1, *pt2;
     h0 = vecPatches( 0 )->hindex;
@@ -1368,15 +1633,12 @@ void SyncVectorPatch::finalizeExchangeAllComponentsAlongX( std::vector<Field *>
     unsigned oversize = vecPatches( 0 )->EMfields->oversize[0];
 
     unsigned int nMPIx = vecPatches.MPIxIdx.size();
-#ifndef _NO_MPI_TM
-    #pragma omp for schedule(static)
-#else
     #pragma omp single
-#endif
+    vecPatches.B_MPI_aggregated[0].wait();
+
+    #pragma omp for schedule(static)
     for( unsigned int ifield=0 ; ifield<nMPIx ; ifield++ ) {
         unsigned int ipatch = vecPatches.MPIxIdx[ifield];
-        vecPatches( ipatch )->finalizeExchange( vecPatches.B_MPIx[ifield      ], 0 ); // By
-        vecPatches( ipatch )->finalizeExchange( vecPatches.B_MPIx[ifield+nMPIx], 0 ); // Bz
         for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
             if ( vecPatches( ipatch )->is_a_MPI_neighbor( 0, ( iNeighbor+1 )%2 ) ) {
                 vecPatches.B_MPIx[ifield      ]->inject_fields_exch( 0, iNeighbor, oversize );
@@ -1415,10 +1677,12 @@ void SyncVectorPatch::exchangeAllComponentsAlongY( std::vector<Field *> &fields,
                 vecPatches.B1_MPIy[ifield+nMPIy]->extract_fields_exch( 1, iNeighbor, oversize );
             }
         }
-        vecPatches( ipatch )->initExchange( vecPatches.B1_MPIy[ifield      ], 1, smpi ); // Bx
-        vecPatches( ipatch )->initExchange( vecPatches.B1_MPIy[ifield+nMPIy], 1, smpi ); // Bz
     }
 
+    // One message per side and neighbour MPI process for all patches and both components
+    #pragma omp single
+    vecPatches.B_MPI_aggregated[1].start( vecPatches.B1_MPIy, vecPatches.MPIyIdx, 2, 1, vecPatches, smpi );
+
     unsigned int h0, n_space;
     double *pt1, *pt2;
     h0 = vecPatches( 0 )->hindex;
@@ -1472,15 +1736,12 @@ void SyncVectorPatch::finalizeExchangeAllComponentsAlongY( std::vector<Field *>
     unsigned oversize = vecPatches( 0 )->EMfields->oversize[1];
 
     unsigned int nMPIy = vecPatches.MPIyIdx.size();
-#ifndef _NO_MPI_TM
-    #pragma omp for schedule(static)
-#else
     #pragma omp single
-#endif
+    vecPatches.B_MPI_aggregated[1].wait();
+
+    #pragma omp for schedule(static)
     for( unsigned int ifield=0 ; ifield<nMPIy ; ifield++ ) {
         unsigned int ipatch = vecPatches.MPIyIdx[ifield];
-        vecPatches( ipatch )->finalizeExchange( vecPatches.B1_MPIy[ifield      ], 1 ); // By
-        vecPatches( ipatch )->finalizeExchange( vecPatches.B1_MPIy[ifield+nMPIy], 1 ); // Bz
         for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
             if ( vecPatches( ipatch )->is_a_MPI_neighbor( 1, ( iNeighbor+1 )%2 ) ) {
                 vecPatches.B1_MPIy[ifield      ]->inject_fields_exch( 1, iNeighbor, oversize );
@@ -1519,10 +1780,12 @@ void SyncVectorPatch::exchangeAllComponentsAlongZ( std::vector<Field *> fields,
                 vecPatches.B2_MPIz[ifield+nMPIz]->extract_fields_exch( 2, iNeighbor, oversize );
             }
         }
-        vecPatches( ipatch )->initExchange( vecPatches.B2_MPIz[ifield],       2, smpi ); // Bx
-        vecPatches( ipatch )->initExchange( vecPatches.B2_MPIz[ifield+nMPIz], 2, smpi ); // By
     }
 
+    // One message per side and neighbour MPI process for all patches and both components
+    #pragma omp single
+    vecPatches.B_MPI_aggregated[2].start( vecPatches.B2_MPIz, vecPatches.MPIzIdx, 2, 2, vecPatches, smpi );
+
     unsigned int h0, n_space;
     double *pt1, *pt2;
     h0 = vecPatches( 0 )->hindex;
@@ -1573,15 +1836,12 @@ void SyncVectorPatch::finalizeExchangeAllComponentsAlongZ( std::vector<Field *>
     unsigned oversize = vecPatches( 0 )->EMfields->oversize[2];
 
     unsigned int nMPIz = vecPatches.MPIzIdx.size();
-#ifndef _NO_MPI_TM
-    #pragma omp for schedule(static)
-#else
     #pragma omp single
-#endif
+    vecPatches.B_MPI_aggregated[2].wait();
+
+    #pragma omp for schedule(static)
     for( unsigned int ifield=0 ; ifield<nMPIz ; ifield++ ) {
         unsigned int ipatch = vecPatches.MPIzIdx[ifield];
-        vecPatches( ipatch )->finalizeExchange( vecPatches.B2_MPIz[ifield      ], 2 ); // Bx
-        vecPatches( ipatch )->finalizeExchange( vecPatches.B2_MPIz[ifield+nMPIz], 2 ); // By
         for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
             if ( vecPatches( ipatch )->is_a_MPI_neighbor( 2, ( iNeighbor+1 )%2 ) ) {
                 vecPatches.B2_MPIz[ifield      ]->inject_fields_exch( 2, iNeighbor, oversize );
@@ -29,6 +29,10 @@ public :
     static void sumRhoJs( Params &params, VectorPatch &vecPatches, int ispec, SmileiMPI *smpi, Timers &timers, int itime );
     //! Densities synchronization per species per mode
     static void sumRhoJs( Params &params, VectorPatch &vecPatches, int imode, int ispec, SmileiMPI *smpi, Timers &timers, int itime );
+    //! Densities synchronization, all modes in a single message per patch and neighbor
+    static void sumRhoJAllModes( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi, Timers &timers, int itime );
+    //! Densities synchronization per species, all modes in a single message per patch and neighbor
+    static void sumRhoJsAllModes( Params &params, VectorPatch &vecPatches, int ispec, SmileiMPI *smpi, Timers &timers, int itime );
     //! Densities synchronization, including envelope
     static void sumEnvChi( Params &params, VectorPatch &vecPatches, SmileiMPI *smp, Timers &timers, int itime );
     static void sumEnvChis( Params &params, VectorPatch &vecPatches, int ispec, SmileiMPI *smp, Timers &timers, int itime );
@@ -287,6 +291,9 @@ public :
 
     static void sumAllComponents( std::vector<Field *> &fields, VectorPatch &vecPatches, SmileiMPI *smpi, Timers &timers, int itime );
 
+    // fields[imode] : contains a single complex field component for all patches of vecPatches (AM geometry)
+    static void sumAllModes( std::vector<std::vector<Field *>> &fields, VectorPatch &vecPatches, SmileiMPI *smpi, Timers &timers, int itime );
+
     void templateGenerator();
 
     //! Fields synchronization
@@ -300,6 +307,9 @@ public :
     static void exchangeB( Params &params, VectorPatch &vecPatches, int imode, SmileiMPI *smpi );
     static void finalizeexchangeB( Params &params, VectorPatch &vecPatches, int imode );
 
+    static void exchangeEAllModes( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi );
+    static void exchangeBAllModes( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi );
+
     static void exchangeJ( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi );
     static void finalizeexchangeJ( Params &params, VectorPatch &vecPatches );
 
@@ -318,6 +328,9 @@ public :
     template<typename T, typename MT> static void exchangeAlongAllDirections( std::vector<Field *> fields, VectorPatch &vecPatches, SmileiMPI *smpi );
     static void finalizeExchangeAlongAllDirections( std::vector<Field *> fields, VectorPatch &vecPatches );
 
+    static void exchangeAllModesAlongAllDirections( std::vector<std::vector<Field *>> &fields, VectorPatch &vecPatches, SmileiMPI *smpi );
+    static void finalizeExchangeAllModesAlongAllDirections( std::vector<std::vector<Field *>> &fields, VectorPatch &vecPatches );
+
     template<typename T, typename MT> static void exchangeAlongAllDirectionsNoOMP( std::vector<Field *> fields, VectorPatch &vecPatches, SmileiMPI *smpi );
     static void finalizeExchangeAlongAllDirectionsNoOMP( std::vector<Field *> fields, VectorPatch &vecPatches );
 
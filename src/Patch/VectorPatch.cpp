@@ -9,6 +9,8 @@
 //#include <string>
 
 #include "BinaryProcesses.h"
+#include "PartCompTimeCalibration.h"
+#include "PartCompTimeFactory.h"
 #include "DomainDecompositionFactory.h"
 #include "PatchesFactory.h"
 #include "Species.h"
@@ -35,12 +37,19 @@ using namespace std;
 VectorPatch::VectorPatch()
 {
     domain_decomposition_ = NULL ;
+    patch_timers_ = false;
+    cost_model_calibration_ = NULL;
 }
 
 
 VectorPatch::VectorPatch( Params &params )
 {
     domain_decomposition_ = DomainDecompositionFactory::create( params );
+    patch_timers_ = false;
+    cost_model_calibration_ = NULL;
+    if( params.adaptive_cost_model_calibration ) {
+        cost_model_calibration_ = new PartCompTimeCalibration( params.adaptive_cost_model_file, params.adaptive_cost_model_calibration_length );
+    }
 }
 
 
@@ -49,6 +58,9 @@ VectorPatch::~VectorPatch()
     if( domain_decomposition_ != NULL ) {
         delete domain_decomposition_;
     }
+    if( cost_model_calibration_ != NULL ) {
+        delete cost_model_calibration_;
+    }
 }
 
 
@@ -64,6 +76,12 @@ void VectorPatch::close( SmileiMPI *smpiData )
     // Close diagnostics
     closeAllDiags( smpiData );
     
+    // Write the calibrated adaptive vectorization cost model, if the run ended during the calibration
+    if( cost_model_calibration_ ) {
+        vector<double> vecto_coefficients, scalar_coefficients;
+        cost_model_calibration_->fitAndWrite( smpiData, vecto_coefficients, scalar_coefficients );
+    }
+    
     if( diag_timers_.size() ) {
         MESSAGE( "\n\tDiagnostics profile :" );
     }
@@ -258,7 +276,7 @@ void VectorPatch::configuration( Params &params, Timers &timers, int itime )
 // ---------------------------------------------------------------------------------------------------------------------
 // Reconfigure all patches for the new time step
 // ---------------------------------------------------------------------------------------------------------------------
-void VectorPatch::reconfiguration( Params &params, Timers &timers, int itime )
+void VectorPatch::reconfiguration( Params &params, SmileiMPI *smpi, Timers &timers, int itime )
 {
 
     timers.reconfiguration.restart();
@@ -277,6 +295,14 @@ void VectorPatch::reconfiguration( Params &params, Timers &timers, int itime )
     }
     #pragma omp barrier
 
+    // End of the calibration of the cost model: the fitted model is used from now on
+    #pragma omp single
+    {
+        if( cost_model_calibration_ && cost_model_calibration_->endOfReconfiguration() ) {
+            endCostModelCalibration( params, smpi );
+        }
+    }
+
     // Species reconfiguration for best performance
     // Change the status to use vectorized or not-vectorized operators
     // as a function of the metrics
@@ -292,6 +318,40 @@ void VectorPatch::reconfiguration( Params &params, Timers &timers, int itime )
 }
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Fit the cost model of the adaptive vectorization and give it to all species
+// ---------------------------------------------------------------------------------------------------------------------
+void VectorPatch::endCostModelCalibration( Params &params, SmileiMPI *smpi )
+{
+    if( cost_model_calibration_->fitAndWrite( smpi, params.adaptive_cost_model_vecto_, params.adaptive_cost_model_scalar_ ) ) {
+        for( unsigned int ipatch=0 ; ipatch < size() ; ipatch++ ) {
+            for( unsigned int ispec=0 ; ispec<patches_[ipatch]->vecSpecies.size() ; ispec++ ) {
+                Species *spec = species( ipatch, ispec );
+                if( spec->part_comp_time_ ) {
+                    delete spec->part_comp_time_;
+                    spec->part_comp_time_ = PartCompTimeFactory::create( params );
+                }
+            }
+        }
+    } else {
+        WARNING( "Adaptive vectorization calibration failed: the built-in cost model is used" );
+    }
+    // The species stop alternating modes and the dynamics are no longer timed
+    params.adaptive_cost_model_calibration = false;
+    delete cost_model_calibration_;
+    cost_model_calibration_ = NULL;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Drop the aggregated B messages, rebuilt at the next exchange
+// ---------------------------------------------------------------------------------------------------------------------
+void VectorPatch::invalidateAggregatedMPIbuffers()
+{
+    for( unsigned int iDim=0 ; iDim<3 ; iDim++ ) {
+        B_MPI_aggregated[iDim].clear();
+    }
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Sort all patches for the new time step
 // ---------------------------------------------------------------------------------------------------------------------
@@ -323,6 +383,7 @@ void VectorPatch::dynamics( Params &params,
     {
         diag_flag = ( needsRhoJsNow( itime ) || params.is_spectral );
     }
+    updateSpeciesFieldsAllocation( params );
 
     timers.particles.restart();
     ostringstream t;
@@ -340,10 +401,22 @@ void VectorPatch::dynamics( Params &params,
                 continue;
             }
 
+            // Nothing to push nor to project for an empty species
+            // (particles arriving later are handled by exchangeParticles)
+            if( spec->getNbrOfParticles() == 0 ) {
+                continue;
+            }
+
             if( spec->isProj( time_dual, simWindow ) || diag_flag ) {
+                double timer = 0.;
+                if( patch_timers_ || cost_model_calibration_ ) {
+                    timer = MPI_Wtime();
+                }
+                // Between two pushes, a sub-cycled species is handled as a frozen species
+                double spec_time_dual = spec->pushTimeDual( time_dual, itime );
                 // Dynamics with vectorized operators
                 if( spec->vectorized_operators ) {
-                    spec->dynamics( time_dual, ispec,
+                    spec->dynamics( spec_time_dual, ispec,
                                     emfields( ipatch ),
                                     params, diag_flag, partwalls( ipatch ),
                                     ( *this )( ipatch ), smpi,
@@ -354,7 +427,7 @@ void VectorPatch::dynamics( Params &params,
                 // Dynamics with scalar operators
                 else {
                     if( params.vectorization_mode == "adaptive" ) {
-                        spec->scalarDynamics( time_dual, ispec,
+                        spec->scalarDynamics( spec_time_dual, ispec,
                                                emfields( ipatch ),
                                                params, diag_flag, partwalls( ipatch ),
                                                ( *this )( ipatch ), smpi,
@@ -362,7 +435,7 @@ void VectorPatch::dynamics( Params &params,
                                                MultiphotonBreitWheelerTables,
                                                localDiags );
                     } else {
-                        spec->Species::dynamics( time_dual, ispec,
+                        spec->Species::dynamics( spec_time_dual, ispec,
                                                  emfields( ipatch ),
                                                  params, diag_flag, partwalls( ipatch ),
                                                  ( *this )( ipatch ), smpi,
@@ -371,6 +444,18 @@ void VectorPatch::dynamics( Params &params,
                                                  localDiags );
                     }
                 } // end if condition on vectorization
+                if( spec->push_every_ > 1 && spec_time_dual > spec->time_frozen_ ) {
+                    spec->checkPushDisplacement( params );
+                }
+                if( patch_timers_ || cost_model_calibration_ ) {
+                    double elapsed = MPI_Wtime() - timer;
+                    if( patch_timers_ ) {
+                        spec->timer_dynamics_ += elapsed;
+                    }
+                    if( cost_model_calibration_ ) {
+                        cost_model_calibration_->addSample( spec->vectorized_operators, spec->count, elapsed );
+                    }
+                }
             } // end if condition on species
         } // end loop on species
         //MESSAGE("species dynamics");
@@ -391,7 +476,8 @@ void VectorPatch::dynamics( Params &params,
     timers.syncPart.restart();
     for( unsigned int ispec=0 ; ispec<( *this )( 0 )->vecSpecies.size(); ispec++ ) {
         Species *spec = species( 0, ispec );
-        if ( (!params.Laser_Envelope_model) && (spec->isProj( time_dual, simWindow )) ){
+        // Sub-cycled species only move, thus exchange particles, at push iterations
+        if ( (!params.Laser_Envelope_model) && (spec->isProj( time_dual, simWindow )) && spec->isPushStep( itime ) ){
             SyncVectorPatch::exchangeParticles( ( *this ), ispec, params, smpi, timers, itime ); // Included sortParticles
         } // end condition on Species and on envelope model
     } // end loop on species
@@ -414,6 +500,7 @@ void VectorPatch::projectionForDiags( Params &params,
 
     #pragma omp single
     diag_flag = needsRhoJsNow( itime );
+    updateSpeciesFieldsAllocation( params );
 
     #pragma omp for schedule(runtime)
     for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
@@ -461,7 +548,8 @@ void VectorPatch::finalizeAndSortParticles( Params &params, SmileiMPI *smpi, Sim
     // ----------------------------------------
 
     for( unsigned int ispec=0 ; ispec<( *this )( 0 )->vecSpecies.size(); ispec++ ) {
-        if( ( *this )( 0 )->vecSpecies[ispec]->isProj( time_dual, simWindow ) ) {
+        // The exchange of sub-cycled species is only initiated at push iterations (see dynamics)
+        if( ( *this )( 0 )->vecSpecies[ispec]->isProj( time_dual, simWindow ) && species( 0, ispec )->isPushStep( itime ) ) {
             SyncVectorPatch::finalizeAndSortParticles( ( *this ), ispec, params, smpi, timers, itime ); // Included sortParticles
         }
 
@@ -475,7 +563,8 @@ void VectorPatch::finalizeAndSortParticles( Params &params, SmileiMPI *smpi, Sim
         // Particle importation for all species
         for( unsigned int ispec=0 ; ispec<( *this )( ipatch )->vecSpecies.size() ; ispec++ ) {
             if( ( *this )( ipatch )->vecSpecies[ispec]->isProj( time_dual, simWindow ) || diag_flag ) {
-                species( ipatch, ispec )->dynamicsImportParticles( time_dual, ispec,
+                // Ionization electrons are imported at every iteration, the other products only at push iterations
+                species( ipatch, ispec )->dynamicsImportParticles( species( ipatch, ispec )->pushTimeDual( time_dual, itime ), ispec,
                         params,
                         ( *this )( ipatch ), smpi,
                         localDiags );
@@ -866,9 +955,7 @@ void VectorPatch::sumDensities( Params &params, double time_dual, Timers &timers
     } else {
 
         if ( (!params.multiple_decomposition)||(itime==0) )
-            for( unsigned int imode = 0 ; imode < static_cast<ElectroMagnAM *>( patches_[0]->EMfields )->Jl_.size() ; imode++ ) {
-                SyncVectorPatch::sumRhoJ( params, ( *this ), imode, smpi, timers, itime );
-            }
+            SyncVectorPatch::sumRhoJAllModes( params, ( *this ), smpi, timers, itime ); // MPI
     }
 
     if( diag_flag ) {
@@ -878,9 +965,7 @@ void VectorPatch::sumDensities( Params &params, double time_dual, Timers &timers
                 if( params.geometry != "AMcylindrical" ) {
                     SyncVectorPatch::sumRhoJs( params, ( *this ), ispec, smpi, timers, itime ); // MPI
                 } else {
-                    for( unsigned int imode = 0 ; imode < static_cast<ElectroMagnAM *>( patches_[0]->EMfields )->Jl_.size() ; imode++ ) {
-                        SyncVectorPatch::sumRhoJs( params, ( *this ), imode, ispec, smpi, timers, itime );
-                    }
+                    SyncVectorPatch::sumRhoJsAllModes( params, ( *this ), ispec, smpi, timers, itime ); // MPI
                 }
             }
         }
@@ -1000,14 +1085,12 @@ void VectorPatch::solveMaxwell( Params &params, SimWindow *simWindow, int itime,
                     SyncVectorPatch::finalizeExchangeAlongAllDirections( listJz_, *this );
                 }
             } else {
-                for (unsigned int imode=0 ; imode < params.nmodes; imode++) {
-                    SyncVectorPatch::exchangeAlongAllDirections<complex<double>,cField>( listJl_[imode], *this, smpi );
-                    SyncVectorPatch::finalizeExchangeAlongAllDirections( listJl_[imode], *this );
-                    SyncVectorPatch::exchangeAlongAllDirections<complex<double>,cField>( listJr_[imode], *this, smpi );
-                    SyncVectorPatch::finalizeExchangeAlongAllDirections( listJr_[imode], *this );
-                    SyncVectorPatch::exchangeAlongAllDirections<complex<double>,cField>( listJt_[imode], *this, smpi );
-                    SyncVectorPatch::finalizeExchangeAlongAllDirections( listJt_[imode], *this );
-                }
+                SyncVectorPatch::exchangeAllModesAlongAllDirections( listJl_, *this, smpi );
+                SyncVectorPatch::finalizeExchangeAllModesAlongAllDirections( listJl_, *this );
+                SyncVectorPatch::exchangeAllModesAlongAllDirections( listJr_, *this, smpi );
+                SyncVectorPatch::finalizeExchangeAllModesAlongAllDirections( listJr_, *this );
+                SyncVectorPatch::exchangeAllModesAlongAllDirections( listJt_, *this, smpi );
+                SyncVectorPatch::finalizeExchangeAllModesAlongAllDirections( listJt_, *this );
             }
         }
     }
@@ -1040,12 +1123,9 @@ void VectorPatch::solveMaxwell( Params &params, SimWindow *simWindow, int itime,
         }
         SyncVectorPatch::exchangeB( params, ( *this ), smpi );
     } else {
-        for( unsigned int imode = 0 ; imode < static_cast<ElectroMagnAM *>( patches_[0]->EMfields )->El_.size() ; imode++ ) {
-            SyncVectorPatch::exchangeE( params, ( *this ), imode, smpi );
-            //SyncVectorPatch::finalizeexchangeE( params, ( *this ), imode ); // disable async, because of tags which is the same for all modes
-            SyncVectorPatch::exchangeB( params, ( *this ), imode, smpi );
-            //SyncVectorPatch::finalizeexchangeB( params, ( *this ), imode ); // disable async, because of tags which is the same for all modes
-        }
+        // All modes of a component are exchanged in a single message per patch and neighbor
+        SyncVectorPatch::exchangeEAllModes( params, ( *this ), smpi );
+        SyncVectorPatch::exchangeBAllModes( params, ( *this ), smpi );
     }
     timers.syncField.update( params.printNow( itime ) );
 
@@ -1318,13 +1398,27 @@ void VectorPatch::runAllDiags( Params &params, SmileiMPI *smpi, unsigned int iti
         diag_timers_[idiag]->restart();
         
         #pragma omp single
-        globalDiags[idiag]->theTimeIsNow_ = globalDiags[idiag]->prepare( itime );
+        {
+            globalDiags[idiag]->theTimeIsNow_ = globalDiags[idiag]->prepare( itime );
+            if( globalDiags[idiag]->theTimeIsNow_ ) {
+                globalDiags[idiag]->updatePatchIndex( *this, itime );
+            }
+        }
         
         if( globalDiags[idiag]->theTimeIsNow_ ) {
-            // All patches run
-            #pragma omp for schedule(runtime)
-            for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
-                globalDiags[idiag]->run( ( *this )( ipatch ), itime, simWindow );
+            vector<unsigned int> *patch_index = globalDiags[idiag]->patchIndex();
+            if( patch_index ) {
+                // Only the indexed patches run
+                #pragma omp for schedule(runtime)
+                for( unsigned int i=0 ; i<patch_index->size() ; i++ ) {
+                    globalDiags[idiag]->run( ( *this )( ( *patch_index )[i] ), itime, simWindow );
+                }
+            } else {
+                // All patches run
+                #pragma omp for schedule(runtime)
+                for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
+                    globalDiags[idiag]->run( ( *this )( ipatch ), itime, simWindow );
+                }
             }
             // MPI procs gather the data and compute
             #pragma omp single
@@ -2725,6 +2819,9 @@ void VectorPatch::loadBalance( Params &params, double time_dual, SmileiMPI *smpi
     // Proceed to patch exchange, and delete patch which moved
     this->exchangePatches( smpi, params );
 
+    // The neighbour MPI processes of the patches changed
+    invalidateAggregatedMPIbuffers();
+
     // Tell that the patches moved this iteration (needed for probes)
     lastIterationPatchesMoved = itime;
 
@@ -3200,6 +3297,8 @@ void VectorPatch::updateFieldList( SmileiMPI *smpi )
     B2_localz.clear();
     B2_MPIz.clear();
 
+    invalidateAggregatedMPIbuffers();
+
     for( unsigned int ipatch=0 ; ipatch < size() ; ipatch++ ) {
         densities[ipatch         ] = patches_[ipatch]->EMfields->Jx_ ;
         densities[ipatch+  size()] = patches_[ipatch]->EMfields->Jy_ ;
@@ -3740,20 +3839,7 @@ void VectorPatch::allocateField( unsigned int ifield, Params &params )
 {
     for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
         if( params.geometry != "AMcylindrical" ) {
-            Field *field = emfields( ipatch )->allFields[ifield];
-            if( field->data_ != NULL ) {
-                continue;
-            }
-            if( ( field->name.substr( 0, 2 )=="Jx" ) && (!params.is_pxr) ) {
-                field->allocateDims( 0, false );
-            } else if( ( field->name.substr( 0, 2 )=="Jy" ) && (!params.is_pxr) ) {
-                field->allocateDims( 1, false );
-            } else if( ( field->name.substr( 0, 2 )=="Jz" ) && (!params.is_pxr) ) {
-                field->allocateDims( 2, false );
-            } else if( ( field->name.substr( 0, 2 )=="Rh" ) || (params.is_pxr) ) {
-                field->allocateDims();
-            }
-            //MESSAGE("HNA4");
+            allocateFieldData( emfields( ipatch )->allFields[ifield], params );
         } else {
             cField2D *field = static_cast<cField2D *>( emfields( ipatch )->allFields[ifield] );
             if( field->cdata_ != NULL ) {
@@ -3773,6 +3859,55 @@ void VectorPatch::allocateField( unsigned int ifield, Params &params )
 }
 
 
+void VectorPatch::allocateFieldData( Field *field, Params &params )
+{
+    if( field->data_ != NULL ) {
+        return;
+    }
+    // Already allocated once: the dimensions include the staggering
+    if( ! field->isDual_.empty() ) {
+        field->allocateDims();
+        return;
+    }
+    if( ( field->name.substr( 0, 2 )=="Jx" ) && (!params.is_pxr) ) {
+        field->allocateDims( 0, false );
+    } else if( ( field->name.substr( 0, 2 )=="Jy" ) && (!params.is_pxr) ) {
+        field->allocateDims( 1, false );
+    } else if( ( field->name.substr( 0, 2 )=="Jz" ) && (!params.is_pxr) ) {
+        field->allocateDims( 2, false );
+    } else if( ( field->name.substr( 0, 2 )=="Rh" ) || (params.is_pxr) ) {
+        field->allocateDims();
+    }
+}
+
+
+// The species-specific densities kept by createDiags are only needed on the iterations
+// when diagnostics use them (diag_flag): their data is released in between
+void VectorPatch::updateSpeciesFieldsAllocation( Params &params )
+{
+    if( params.geometry == "AMcylindrical" ) {
+        return;
+    }
+    #pragma omp for schedule(static)
+    for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
+        ElectroMagn *EM = emfields( ipatch );
+        for( unsigned int ispec=0 ; ispec<EM->Jx_s.size() ; ispec++ ) {
+            Field *fields[4] = { EM->Jx_s[ispec], EM->Jy_s[ispec], EM->Jz_s[ispec], EM->rho_s[ispec] };
+            for( unsigned int k=0 ; k<4 ; k++ ) {
+                if( ! fields[k] ) {
+                    continue;
+                }
+                if( diag_flag ) {
+                    allocateFieldData( fields[k], params );
+                } else if( fields[k]->data_ ) {
+                    fields[k]->deallocateData();
+                }
+            }
+        }
+    }
+}
+
+
 // For each patch, apply external fields
 void VectorPatch::applyExternalFields()
 {
@@ -4071,6 +4206,7 @@ void VectorPatch::ponderomotiveUpdateSusceptibilityAndMomentum( Params &params,
 
     #pragma omp single
     diag_flag = needsRhoJsNow( itime );
+    updateSpeciesFieldsAllocation( params );
 
     timers.particles.restart();
 
@@ -4121,6 +4257,7 @@ void VectorPatch::ponderomotiveUpdatePositionAndCurrents( Params &params,
 
     #pragma omp single
     diag_flag = needsRhoJsNow( itime );
+    updateSpeciesFieldsAllocation( params );
 
     timers.particles.restart();
 
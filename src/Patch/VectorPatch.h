@@ -24,6 +24,7 @@ class Field;
 class Timer;
 class SimWindow;
 class DomainDecomposition;
+class PartCompTimeCalibration;
 
 //! Class vectorPatch
 //! This class corresponds to the MPI Patch Collection.
@@ -111,7 +112,10 @@ public :
     void configuration( Params &params, Timers &timers, int itime );
     
     //! Reconfigure all patches for the new time step
-    void reconfiguration( Params &params, Timers &timers, int itime );
+    void reconfiguration( Params &params, SmileiMPI *smpi, Timers &timers, int itime );
+    
+    //! End the calibration of the adaptive vectorization cost model: fit, write and use the model
+    void endCostModelCalibration( Params &params, SmileiMPI *smpi );
     
     //! Particle sorting for all patches
     void sortAllParticles( Params &params );
@@ -213,6 +217,12 @@ public :
     //! For all patches, allocate a field if not allocated
     void allocateField( unsigned int ifield, Params &params );
     
+    //! Allocate a (non-AM) field if not allocated, with the staggering given by its name
+    static void allocateFieldData( Field *field, Params &params );
+    
+    //! For all patches, allocate the species-specific densities when diag_flag is set, release them otherwise
+    void updateSpeciesFieldsAllocation( Params &params );
+    
     //! For each patch, apply external fields
     void applyExternalFields();
     
@@ -271,6 +281,12 @@ public :
     std::vector<Field *> B2_localz;
     std::vector<Field *> B2_MPIz;
     
+    //! Messages of B_MPIx, B1_MPIy and B2_MPIz aggregated per neighbour MPI process
+    AggregatedMPIbuffers B_MPI_aggregated[3];
+    
+    //! Drop the aggregated messages: to be called whenever the field lists or the patch distribution change
+    void invalidateAggregatedMPIbuffers();
+    
     std::vector<Field *> listJx_;
     std::vector<Field *> listJy_;
     std::vector<Field *> listJz_;
@@ -374,6 +390,12 @@ public :
     // Keep track if we need the needsRhoJsNow
     int diag_flag;
     
+    //! Whether the dynamics of each species is timed in each patch (DiagPerformances patch_timers)
+    bool patch_timers_;
+    
+    //! Measures of the species dynamics to calibrate the adaptive vectorization cost model (Vectorization.cost_model_file)
+    PartCompTimeCalibration *cost_model_calibration_;
+    
     int nrequests;
     
     //! Tells which iteration was last time the patches moved (by moving window or load balancing)
@@ -20,9 +20,10 @@ Pusher::Pusher( Params &params, Species *species ) :
     } else {
         one_over_mass_ = 0.;
     }
-    dt             = params.timestep;
-    dts2           = params.timestep/2.;
-    dts4           = params.timestep/4.;
+    // Sub-cycled species are pushed with a larger timestep
+    dt             = params.timestep * species->push_every_;
+    dts2           = dt/2.;
+    dts4           = dt/4.;
     
     nDim_          = params.nDim_particle;
     
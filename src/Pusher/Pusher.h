@@ -19,6 +19,7 @@ public:
     virtual ~Pusher();
     
     //! Overloading of () operator
+    //! Pushers templated on the dimension pick it here, once per call, rather than in the particle loop
     virtual void operator()( Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, int ipart_buffer_offset = 0 ) = 0;
     
 protected:
@@ -26,14 +26,26 @@ PusherBoris::~PusherBoris()
 ***********************************************************************/
 
 void PusherBoris::operator()( Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, int ipart_buffer_offset )
+{
+    if( nDim_ == 1 ) {
+        push<1>( particles, smpi, istart, iend, ithread, ipart_buffer_offset );
+    } else if( nDim_ == 2 ) {
+        push<2>( particles, smpi, istart, iend, ithread, ipart_buffer_offset );
+    } else {
+        push<3>( particles, smpi, istart, iend, ithread, ipart_buffer_offset );
+    }
+}
+
+template<int nDim>
+void PusherBoris::push( Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, int ipart_buffer_offset )
 {
 
     const int nparts = vecto ? smpi->dynamics_Epart[ithread].size() / 3 :
                                particles.last_index.back(); // particles.size()
 
     double *const __restrict__ position_x = particles.getPtrPosition( 0 );
-    double *const __restrict__ position_y = nDim_ > 1 ? particles.getPtrPosition( 1 ) : nullptr;
-    double *const __restrict__ position_z = nDim_ > 2 ? particles.getPtrPosition( 2 ) : nullptr;
+    double *const __restrict__ position_y = nDim > 1 ? particles.getPtrPosition( 1 ) : nullptr;
+    double *const __restrict__ position_z = nDim > 2 ? particles.getPtrPosition( 2 ) : nullptr;
     
     double *const __restrict__ momentum_x = particles.getPtrMomentum(0);
     double *const __restrict__ momentum_y = particles.getPtrMomentum(1);
@@ -89,9 +101,9 @@ void PusherBoris::operator()( Particles &particles, SmileiMPI *smpi, int istart,
         local_invgf *= dt;
         //position_x[ipart] += dt*momentum_x[ipart]*invgf[ipart2];
         position_x[ipart] += pxsm*local_invgf;
-        if (nDim_>1) {
+        if( nDim>1 ) {
             position_y[ipart] += pysm*local_invgf;
-            if (nDim_>2) {
+            if( nDim>2 ) {
                 position_z[ipart] += pzsm*local_invgf;
             }
         }
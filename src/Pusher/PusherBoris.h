@@ -22,6 +22,11 @@ public:
     //! Overloading of () operator
     virtual void operator()( Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, int ipart_buffer_offset = 0 );
     
+private:
+    //! Push with the number of dimensions known at compile time
+    template<int nDim>
+    void push( Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, int ipart_buffer_offset );
+    
 };
 
 #endif
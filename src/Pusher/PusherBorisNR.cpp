@@ -19,6 +19,18 @@ PusherBorisNR::~PusherBorisNR()
 ***********************************************************************/
 
 void PusherBorisNR::operator()( Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, int ipart_buffer_offset )
+{
+    if( nDim_ == 1 ) {
+        push<1>( particles, smpi, istart, iend, ithread, ipart_buffer_offset );
+    } else if( nDim_ == 2 ) {
+        push<2>( particles, smpi, istart, iend, ithread, ipart_buffer_offset );
+    } else {
+        push<3>( particles, smpi, istart, iend, ithread, ipart_buffer_offset );
+    }
+}
+
+template<int nDim>
+void PusherBorisNR::push( Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, int ipart_buffer_offset )
 {
     std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
     std::vector<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
@@ -34,8 +46,8 @@ void PusherBorisNR::operator()( Particles &particles, SmileiMPI *smpi, int istar
     const double *const __restrict__ Bz = &( ( *Bpart )[2*nparts] );
 
     double *const __restrict__ position_x = particles.getPtrPosition( 0 );
-    double *const __restrict__ position_y = nDim_ > 1 ? particles.getPtrPosition( 1 ) : nullptr;
-    double *const __restrict__ position_z = nDim_ > 2 ? particles.getPtrPosition( 2 ) : nullptr;
+    double *const __restrict__ position_y = nDim > 1 ? particles.getPtrPosition( 1 ) : nullptr;
+    double *const __restrict__ position_z = nDim > 2 ? particles.getPtrPosition( 2 ) : nullptr;
 
     double *const __restrict__ momentum_x = particles.getPtrMomentum( 0 );
     double *const __restrict__ momentum_y = particles.getPtrMomentum( 1 );
@@ -81,9 +93,9 @@ void PusherBorisNR::operator()( Particles &particles, SmileiMPI *smpi, int istar
 
         // Move the particle
         position_x[ipart] += dt * momentum_x[ipart];
-        if (nDim_>1) {
+        if( nDim>1 ) {
             position_y[ipart] += dt * momentum_y[ipart];
-            if (nDim_>2) {
+            if( nDim>2 ) {
                 position_z[ipart] += dt * momentum_z[ipart];
             }
         }
@@ -40,7 +40,7 @@ def _smilei_check():
             "DiagTrackParticles","DiagPerformances","ExternalField","PrescribedField",
             "SmileiSingleton","Main","Checkpoints","LoadBalancing","MovingWindow",
             "RadiationReaction", "ParticleData", "MultiphotonBreitWheeler",
-            "Vectorization", "MultipleDecomposition"]:
+            "Vectorization", "MultipleDecomposition", "Autotuning"]:
         CheckClass = globals()[CheckClassName]
         try:
             if not CheckClass._verify: raise Exception("")
@@ -55,8 +55,13 @@ def _smilei_check():
             if Checkpoints.file_grouping:
                 pattern += "*"+ os.sep
             pattern += "dump-*-*.h5"
+            all_files = glob(pattern)
             # pick those file that match the mpi rank
-            files = filter(lambda a: smilei_mpi_rank==int(search(r'dump-[0-9]*-([0-9]*).h5$',a).groups()[-1]), glob(pattern))
+            files = list(filter(lambda a: smilei_mpi_rank==int(search(r'dump-[0-9]*-([0-9]*).h5$',a).groups()[-1]), all_files))
+            # restart on more processes than the previous run: the extra ranks
+            # read the header of the files of rank 0, then the patches from any file
+            if len(files) == 0:
+                files = list(filter(lambda a: 0==int(search(r'dump-[0-9]*-([0-9]*).h5$',a).groups()[-1]), all_files))
             
             if Checkpoints.restart_number is not None:
                 # pick those file that match the restart_number
@@ -152,7 +157,7 @@ def _keep_python_running():
         return True
     # Verify the tracked species that require a particle selection
     for d in DiagTrackParticles:
-        if d.filter is not None:
+        if d.filter is not None and type(d.filter) is not str:
             return True
     # Verify the particle binning having a function for deposited_quantity or axis type
     for d in DiagParticleBinning._list + DiagScreen._list:
@@ -170,6 +170,7 @@ class Main(SmileiSingleton):
     number_of_patches = None
     patch_arrangement = "hilbertian"
     cluster_width = -1
+    cluster_tile_width = 0
     every_clean_particles_overhead = 100
     timestep = None
     number_of_AM = 2
@@ -324,6 +325,15 @@ class Vectorization(SmileiSingleton):
     mode                = "off"
     reconfigure_every   = 20
     initial_mode        = "off"
+    cost_model_file     = ""
+    calibration_reconfigurations = 10
+
+
+class Autotuning(SmileiSingleton):
+    """Online tuning of performance parameters"""
+    window       = 100
+    retune_every = 5000
+    parameters   = ["load_balancing", "vectorization"]
 
 
 class MovingWindow(SmileiSingleton):
@@ -333,6 +343,7 @@ class MovingWindow(SmileiSingleton):
     velocity_x = 1.
     number_of_additional_shifts = 0
     additional_shifts_time = 0.
+    particle_creation_threshold = 0.
 
 
 class Checkpoints(SmileiSingleton):
@@ -401,6 +412,7 @@ class Species(SmileiComponent):
     merge_min_momentum = 1e-5
 
     time_frozen = 0.0
+    push_every = 1
     radiating = False
     relativistic_field_initialization = False
     boundary_conditions = [["periodic"]]
@@ -537,6 +549,7 @@ class DiagTrackParticles(SmileiComponent):
     every = 0
     flush_every = 1
     filter = None
+    select_once = False
     attributes = ["x", "y", "z", "px", "py", "pz", "w"]
 
 class DiagPerformances(SmileiSingleton):
@@ -544,6 +557,7 @@ class DiagPerformances(SmileiSingleton):
     every = 0
     flush_every = 1
     patch_information = True
+    patch_timers = False
 
 # external fields
 class ExternalField(SmileiComponent):
@@ -34,6 +34,7 @@
 #include "DoubleGrids.h"
 #include "DoubleGridsAM.h"
 #include "Timers.h"
+#include "Autotuner.h"
 
 using namespace std;
 
@@ -377,6 +378,8 @@ int main( int argc, char *argv[] )
     
     int count_dlb = 0;
     
+    Autotuner autotuner( params, &smpi );
+    
     unsigned int itime=checkpoint.this_run_start_step+1;
     while( ( itime <= params.n_time ) && ( !checkpoint.exit_asap ) ) {
 
@@ -397,7 +400,7 @@ int main( int argc, char *argv[] )
 
             // Patch reconfiguration
             if( params.has_adaptive_vectorization && params.adaptive_vecto_time_selection->theTimeIsNow( itime ) ) {
-                vecPatches.reconfiguration( params, timers, itime );
+                vecPatches.reconfiguration( params, &smpi, timers, itime );
             }
 
             // apply collisions if requested
@@ -572,6 +575,7 @@ int main( int argc, char *argv[] )
                 for (unsigned int n=0;n < simWindow->getNumberOfAdditionalShifts()-adjust; n++)
                     simWindow->shift( vecPatches, &smpi, params, itime, time_dual, region );
             }
+            simWindow->createDeferredParticles( vecPatches, &smpi, params );
             timers.movWindow.update();
             // ----------------------------------------------------------------------
             // Validate restart  : to do
@@ -640,6 +644,9 @@ int main( int argc, char *argv[] )
             #pragma omp barrier
         }
         
+        // Online tuning of the performance parameters
+        autotuner.update( &smpi, itime );
+        
         itime++;
         
     }//END of the time loop
@@ -2,8 +2,12 @@
 #include "AsyncMPIbuffers.h"
 #include "Field.h"
 #include "Patch.h"
+#include "VectorPatch.h"
+#include "SmileiMPI.h"
 
 #include <vector>
+#include <map>
+#include <algorithm>
 using namespace std;
 
 AsyncMPIbuffers::AsyncMPIbuffers()
@@ -59,6 +63,182 @@ void AsyncMPIbuffers::defineTags( Patch *patch, SmileiMPI *smpi, int tag )
 }
 
 
+AggregatedMPIbuffers::AggregatedMPIbuffers() :
+    ready_( false )
+{
+}
+
+
+AggregatedMPIbuffers::~AggregatedMPIbuffers()
+{
+    clear();
+}
+
+
+void AggregatedMPIbuffers::clear()
+{
+    int finalized( 0 );
+    MPI_Finalized( &finalized );
+    if( !finalized ) {
+        for( unsigned int i=0 ; i<send_types_.size() ; i++ ) {
+            MPI_Type_free( &send_types_[i] );
+        }
+        for( unsigned int i=0 ; i<recv_types_.size() ; i++ ) {
+            MPI_Type_free( &recv_types_[i] );
+        }
+    }
+    send_ranks_.clear();
+    recv_ranks_.clear();
+    send_tags_.clear();
+    recv_tags_.clear();
+    send_types_.clear();
+    recv_types_.clear();
+    requests_.clear();
+    subfields_.clear();
+    allocations_.clear();
+    ready_ = false;
+}
+
+
+void AggregatedMPIbuffers::build( vector<Field *> &fields, vector<int> &idx, unsigned int ncomp, int iDim, VectorPatch &vecPatches, SmileiMPI *smpi )
+{
+    clear();
+    
+    unsigned int nfields = idx.size();
+    for( int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++ ) {
+        int iOpposite = ( iNeighbor+1 )%2;
+        
+        // Group the patches per neighbour MPI process
+        //   - sendings are ordered by the hindex of the sending patch
+        //   - receptions are ordered by the hindex of the neighbour, i.e. in the order of the sender
+        map<int, vector<unsigned int> > send_groups, recv_groups;
+        for( unsigned int ifield=0 ; ifield<nfields ; ifield++ ) {
+            Patch *patch = vecPatches( idx[ifield] );
+            if( patch->is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+                send_groups[patch->MPI_neighbor_[iDim][iNeighbor]].push_back( ifield );
+            }
+            if( patch->is_a_MPI_neighbor( iDim, iOpposite ) ) {
+                recv_groups[patch->MPI_neighbor_[iDim][iOpposite]].push_back( ifield );
+            }
+        }
+        
+        for( map<int, vector<unsigned int> >::iterator it = send_groups.begin() ; it != send_groups.end() ; it++ ) {
+            vector<unsigned int> &group = it->second;
+            vector<int> lengths;
+            vector<MPI_Aint> displs;
+            for( unsigned int i=0 ; i<group.size() ; i++ ) {
+                for( unsigned int icomp=0 ; icomp<ncomp ; icomp++ ) {
+                    Field *sub = fields[group[i]+icomp*nfields]->sendFields_[iDim*2+iNeighbor];
+                    MPI_Aint address;
+                    MPI_Get_address( sub->data_, &address );
+                    displs.push_back( address );
+                    lengths.push_back( sub->globalDims_ );
+                }
+            }
+            MPI_Datatype type;
+            MPI_Type_create_hindexed( lengths.size(), &lengths[0], &displs[0], MPI_DOUBLE, &type );
+            MPI_Type_commit( &type );
+            
+            Patch *first = vecPatches( idx[group[0]] );
+            int local_hindex = first->hindex;
+            if( first->is_small ) {
+                local_hindex -= smpi->patch_refHindexes[first->MPI_me_];
+            }
+            send_ranks_.push_back( it->first );
+            send_tags_.push_back( buildtag( local_hindex, iDim, iNeighbor, 5 ) );
+            send_types_.push_back( type );
+        }
+        
+        for( map<int, vector<unsigned int> >::iterator it = recv_groups.begin() ; it != recv_groups.end() ; it++ ) {
+            vector<unsigned int> &group = it->second;
+            vector<pair<unsigned int, unsigned int> > order;
+            for( unsigned int i=0 ; i<group.size() ; i++ ) {
+                order.push_back( make_pair( vecPatches( idx[group[i]] )->neighbor_[iDim][iOpposite], group[i] ) );
+            }
+            sort( order.begin(), order.end() );
+            vector<int> lengths;
+            vector<MPI_Aint> displs;
+            for( unsigned int i=0 ; i<order.size() ; i++ ) {
+                for( unsigned int icomp=0 ; icomp<ncomp ; icomp++ ) {
+                    Field *sub = fields[order[i].second+icomp*nfields]->recvFields_[iDim*2+iOpposite];
+                    MPI_Aint address;
+                    MPI_Get_address( sub->data_, &address );
+                    displs.push_back( address );
+                    lengths.push_back( sub->globalDims_ );
+                }
+            }
+            MPI_Datatype type;
+            MPI_Type_create_hindexed( lengths.size(), &lengths[0], &displs[0], MPI_DOUBLE, &type );
+            MPI_Type_commit( &type );
+            
+            int local_hindex = order[0].first;
+            if( vecPatches( idx[order[0].second] )->is_small ) {
+                local_hindex -= smpi->patch_refHindexes[it->first];
+            }
+            recv_ranks_.push_back( it->first );
+            recv_tags_.push_back( buildtag( local_hindex, iDim, iNeighbor, 5 ) );
+            recv_types_.push_back( type );
+        }
+    }
+    
+    requests_.resize( send_types_.size() + recv_types_.size(), MPI_REQUEST_NULL );
+    listSubFields( fields, idx, ncomp, iDim, vecPatches, subfields_, allocations_ );
+    ready_ = true;
+}
+
+
+void AggregatedMPIbuffers::listSubFields( vector<Field *> &fields, vector<int> &idx, unsigned int ncomp, int iDim, VectorPatch &vecPatches,
+                                          vector<Field *> &subfields, vector<unsigned int> &allocations )
+{
+    subfields.clear();
+    allocations.clear();
+    unsigned int nfields = idx.size();
+    for( unsigned int ifield=0 ; ifield<nfields ; ifield++ ) {
+        Patch *patch = vecPatches( idx[ifield] );
+        for( int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++ ) {
+            if( patch->is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+                for( unsigned int icomp=0 ; icomp<ncomp ; icomp++ ) {
+                    subfields.push_back( fields[ifield+icomp*nfields]->sendFields_[iDim*2+iNeighbor] );
+                    subfields.push_back( fields[ifield+icomp*nfields]->recvFields_[iDim*2+iNeighbor] );
+                    allocations.push_back( fields[ifield+icomp*nfields]->sub_fields_allocations_ );
+                }
+            }
+        }
+    }
+}
+
+
+void AggregatedMPIbuffers::start( vector<Field *> &fields, vector<int> &idx, unsigned int ncomp, int iDim, VectorPatch &vecPatches, SmileiMPI *smpi )
+{
+    if( ready_ ) {
+        // Sub-fields swapped (other ghost size) or reallocated since the datatypes were built
+        vector<Field *> subfields;
+        vector<unsigned int> allocations;
+        listSubFields( fields, idx, ncomp, iDim, vecPatches, subfields, allocations );
+        ready_ = ( subfields == subfields_ && allocations == allocations_ );
+    }
+    if( !ready_ ) {
+        build( fields, idx, ncomp, iDim, vecPatches, smpi );
+    }
+    
+    unsigned int nrecv = recv_types_.size();
+    for( unsigned int i=0 ; i<nrecv ; i++ ) {
+        MPI_Irecv( MPI_BOTTOM, 1, recv_types_[i], recv_ranks_[i], recv_tags_[i], MPI_COMM_WORLD, &requests_[i] );
+    }
+    for( unsigned int i=0 ; i<send_types_.size() ; i++ ) {
+        MPI_Isend( MPI_BOTTOM, 1, send_types_[i], send_ranks_[i], send_tags_[i], MPI_COMM_WORLD, &requests_[nrecv+i] );
+    }
+}
+
+
+void AggregatedMPIbuffers::wait()
+{
+    if( requests_.size() > 0 ) {
+        MPI_Waitall( requests_.size(), &requests_[0], MPI_STATUSES_IGNORE );
+    }
+}
+
+
 SpeciesMPIbuffers::SpeciesMPIbuffers()
 {
 }
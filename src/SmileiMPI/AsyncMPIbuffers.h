@@ -10,6 +10,7 @@
 class Field;
 class Patch;
 class SmileiMPI;
+class VectorPatch;
 
 class AsyncMPIbuffers
 {
@@ -32,6 +33,52 @@ public:
     
 };
 
+//! Exchange of the sub-fields of several field components along one direction,
+//! aggregated in a single message per side and per neighbour MPI process.
+//! Only used for the B exchange (exchangeAllComponentsAlong{X,Y,Z}).
+//! The MPI datatypes which describe the messages are built at the first exchange
+//! and kept until clear() is called (field lists update, load balancing, moving window)
+//! or the sub-fields are reallocated.
+class AggregatedMPIbuffers
+{
+public:
+    AggregatedMPIbuffers();
+    ~AggregatedMPIbuffers();
+    
+    //! Free the datatypes, they will be rebuilt at the next exchange.
+    //! Must be called whenever the field lists or the patch distribution change
+    void clear();
+    
+    //! Build the datatypes from the sub-fields of fields, which contains ncomp components
+    //! for the patches listed in idx (as B_MPIx and MPIxIdx in VectorPatch)
+    void build( std::vector<Field *> &fields, std::vector<int> &idx, unsigned int ncomp, int iDim, VectorPatch &vecPatches, SmileiMPI *smpi );
+    
+    //! Rebuild the datatypes if the sub-fields were reallocated, then post all the receptions and all the sendings
+    void start( std::vector<Field *> &fields, std::vector<int> &idx, unsigned int ncomp, int iDim, VectorPatch &vecPatches, SmileiMPI *smpi );
+    
+    //! Wait for all the messages posted by start()
+    void wait();
+    
+    //! True if the datatypes match the current patch distribution
+    bool ready_;
+    
+    std::vector<int> send_ranks_, recv_ranks_;
+    std::vector<int> send_tags_, recv_tags_;
+    std::vector<MPI_Datatype> send_types_, recv_types_;
+    std::vector<MPI_Request> requests_;
+    
+private:
+    //! List the sub-fields involved in the exchange, and the allocation counts of their fields,
+    //! to detect their reallocation or swap by create_sub_fields
+    void listSubFields( std::vector<Field *> &fields, std::vector<int> &idx, unsigned int ncomp, int iDim, VectorPatch &vecPatches,
+                        std::vector<Field *> &subfields, std::vector<unsigned int> &allocations );
+    
+    //! Sub-fields described by the current datatypes, and the allocation counts of their fields
+    std::vector<Field *> subfields_;
+    std::vector<unsigned int> allocations_;
+    
+};
+
 class SpeciesMPIbuffers : public AsyncMPIbuffers
 {
 public:
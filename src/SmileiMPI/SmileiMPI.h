@@ -35,6 +35,7 @@ class SmileiMPI
     friend class VectorPatch;
     friend class SimWindow;
     friend class AsyncMPIbuffers;
+    friend class AggregatedMPIbuffers;
 
 public:
     SmileiMPI() {};
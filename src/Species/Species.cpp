@@ -6,6 +6,7 @@
 #include <cstdlib>
 
 #include <iostream>
+#include <algorithm>
 
 #include <omp.h>
 
@@ -57,6 +58,7 @@ Species::Species( Params &params, Patch *patch ) :
     pusher_name_( "boris" ),
     radiation_model_( "none" ),
     time_frozen_( 0 ),
+    push_every_( 1 ),
     radiating_( false ),
     relativistic_field_initialization_( false ),
     iter_relativistic_initialization_( 0 ),
@@ -85,6 +87,7 @@ Species::Species( Params &params, Patch *patch ) :
     //mBW_pair_creation_sampling_( {1,1} ),
     mBW_pair_species_names_( 2, "" ),
     cluster_width_( params.cluster_width_ ),
+    cluster_tile_width_( params.cluster_tile_width_ ),
     oversize( params.oversize ),
     cell_length( params.cell_length ),
     min_loc_vec( patch->getDomainLocalMin() ),
@@ -101,6 +104,7 @@ Species::Species( Params &params, Patch *patch ) :
     partBoundCond = NULL;
     min_loc = patch->getDomainLocalMin( 0 );
     merging_method_ = "none";
+    timer_dynamics_ = 0.;
 
     PI2 = 2.0 * M_PI;
     PI_ov_2 = 0.5*M_PI;
@@ -1056,6 +1060,10 @@ void Species::sortParticles( Params &params, Patch * patch )
         particles->first_index[bin] = particles->last_index[bin-1];
     }
 
+    if( cluster_tile_width_ > 0 ) {
+        tileSortParticles( params );
+    }
+
     //particles->cell_keys.resize( particles->size() );
     particles->resizeCellKeys(particles->size());
 }
@@ -1143,6 +1151,67 @@ void Species::countSortParticles( Params &params )
 
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+//! Sort the particles of each cluster by tiles along Y and Z using a count sort.
+//! The particles of a tile then touch neighbouring rows of the fields during
+//! interpolation and projection.
+// ---------------------------------------------------------------------------------------------------------------------
+void Species::tileSortParticles( Params &params )
+{
+    int ntiles_y = ( params.n_space[1] + cluster_tile_width_ - 1 ) / cluster_tile_width_;
+    int ntiles_z = 1;
+    if( nDim_field == 3 ) {
+        ntiles_z = ( params.n_space[2] + cluster_tile_width_ - 1 ) / cluster_tile_width_;
+    }
+    double inv_tile_length_y = dx_inv_[1] / cluster_tile_width_;
+    double inv_tile_length_z = dx_inv_[2] / cluster_tile_width_;
+
+    std::vector<int> tile_index( ntiles_y*ntiles_z+1 );
+    std::vector<int> keys;
+    std::vector<int> destination;
+
+    for( unsigned int ibin = 0 ; ibin < particles->last_index.size() ; ibin++ ) {
+        int first = particles->first_index[ibin];
+        int npart = particles->last_index[ibin] - first;
+        if( npart < 2 ) {
+            continue;
+        }
+
+        // Count the particles in each tile
+        keys.resize( npart );
+        std::fill( tile_index.begin(), tile_index.end(), 0 );
+        for( int ip = 0 ; ip < npart ; ip++ ) {
+            int iy = ( int )( ( particles->position( 1, first+ip ) - min_loc_vec[1] ) * inv_tile_length_y );
+            iy = std::min( std::max( iy, 0 ), ntiles_y-1 );
+            int iz = 0;
+            if( nDim_field == 3 ) {
+                iz = ( int )( ( particles->position( 2, first+ip ) - min_loc_vec[2] ) * inv_tile_length_z );
+                iz = std::min( std::max( iz, 0 ), ntiles_z-1 );
+            }
+            keys[ip] = iy*ntiles_z + iz;
+            tile_index[keys[ip]+1]++;
+        }
+
+        // Cumulative sum gives the first index of each tile
+        for( unsigned int itile = 1 ; itile < tile_index.size() ; itile++ ) {
+            tile_index[itile] += tile_index[itile-1];
+        }
+        destination.resize( npart );
+        for( int ip = 0 ; ip < npart ; ip++ ) {
+            destination[ip] = tile_index[keys[ip]]++;
+        }
+
+        // Apply the permutation in place, following its cycles
+        for( int ip = 0 ; ip < npart ; ip++ ) {
+            while( destination[ip] != ip ) {
+                int jp = destination[ip];
+                particles->swapParticle( first+ip, first+jp );
+                std::swap( destination[ip], destination[jp] );
+            }
+        }
+    }
+}
+
 // Move all particles from another species to this one
 void Species::importParticles( Params &params, Patch *patch, Particles &source_particles, vector<Diagnostic *> &localDiags )
 {
@@ -1223,6 +1292,31 @@ void Species::importParticles( Params &params, Patch *patch, Particles &source_p
 //} // End updateMvWinLimits
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// The current deposition and the particle exchange assume that particles move by less than one cell
+// during a push, i.e. during push_every_ timesteps for a sub-cycled species
+// ---------------------------------------------------------------------------------------------------------------------
+void Species::checkPushDisplacement( Params &params )
+{
+    double max_v2 = 0.;
+    unsigned int npart = particles->size();
+    for( unsigned int ipart=0 ; ipart<npart ; ipart++ ) {
+        double u2 = 0.;
+        for( unsigned int i=0 ; i<3 ; i++ ) {
+            u2 += particles->momentum( i, ipart ) * particles->momentum( i, ipart );
+        }
+        max_v2 = max( max_v2, u2 / ( 1. + u2 ) );
+    }
+    double max_displacement = sqrt( max_v2 ) * push_every_ * params.timestep;
+    for( unsigned int i=0 ; i<params.nDim_field ; i++ ) {
+        if( max_displacement >= params.cell_length[i] ) {
+            ERROR( "Species '" << name_ << "' moves by " << max_displacement << " during push_every = " << push_every_
+                   << " timesteps, more than the cell length " << params.cell_length[i] << ". Reduce push_every" );
+        }
+    }
+}
+
+
 //Do we have to project this species ?
 bool Species::isProj( double time_dual, SimWindow *simWindow )
 {
@@ -97,6 +97,9 @@ public:
     //! Time for which the species is frozen
     double time_frozen_;
 
+    //! The species is pushed every push_every_ iterations, with a timestep push_every_*dt
+    unsigned int push_every_;
+
     //! logical true if particles radiate
     bool radiating_;
 
@@ -201,6 +204,7 @@ public:
 
     //! Cluster width in number of cells
     unsigned int cluster_width_; //Should divide the number of cells in X of a single MPI domain.
+    unsigned int cluster_tile_width_; //Width in Y and Z of the tiles sorted inside a cluster (0 = no tiling).
     //! Array counting the occurence of each cell key
     std::vector<int> count;
     //! sub dimensions of buffers for dim > 1
@@ -253,6 +257,9 @@ public:
     //! whether to choose vectorized operators with respective sorting methods
     int vectorized_operators;
 
+    //! Accumulated time spent in the dynamics of this species in this patch (DiagPerformances patch_timers)
+    double timer_dynamics_;
+
     // Merging parameters :
     //! Merging method
     std::string merging_method_;
@@ -467,6 +474,9 @@ public:
     //! Counting sort method for particles
     void countSortParticles( Params &param );
 
+    //! Sort particles by tiles of cluster_tile_width_ cells along Y and Z inside each cluster
+    void tileSortParticles( Params &param );
+
     //!
     virtual void addSpaceForOneParticle()
     {
@@ -476,6 +486,21 @@ public:
     //! Method to know if we have to project this species or not.
     bool  isProj( double time_dual, SimWindow *simWindow );
     
+    //! Whether the particles are pushed at this iteration (see push_every_)
+    inline bool isPushStep( int itime )
+    {
+        return itime % ( int )push_every_ == 0;
+    }
+    
+    //! Stop if a particle of a sub-cycled species may cross more than one cell during a push
+    void checkPushDisplacement( Params &params );
+    
+    //! Time seen by the species operators: between two pushes, the species is handled as a frozen species
+    inline double pushTimeDual( double time_dual, int itime )
+    {
+        return isPushStep( itime ) ? time_dual : std::min( time_dual, time_frozen_ );
+    }
+    
     inline double computeEnergy()
     {
         double nrj( 0. );
@@ -798,6 +798,20 @@ public:
             MESSAGE( 2, "> Species frozen until time: " << this_species->time_frozen_ );
         }
 
+        PyTools::extract( "push_every", this_species->push_every_, "Species", ispec );
+        if( this_species->push_every_ == 0 ) {
+            ERROR_NAMELIST( "For species '" << species_name << "', push_every must be a positive integer",
+                LINK_NAMELIST + std::string("#push_every") );
+        }
+        if( this_species->push_every_ > 1 ) {
+            if( this_species->mass_ == 0 || this_species->radiation_model_ != "none" || params.Laser_Envelope_model ) {
+                ERROR_NAMELIST( "For species '" << species_name << "', push_every > 1 is not available for photons,"
+                    << " radiating species or with the envelope model",
+                    LINK_NAMELIST + std::string("#push_every") );
+            }
+            MESSAGE( 2, "> Species pushed every " << this_species->push_every_ << " iterations" );
+        }
+
         // iteration when the relativistic field initialization is applied, if enabled
         this_species->iter_relativistic_initialization_ = ( int )( this_species->time_frozen_/params.timestep );
 
@@ -1196,6 +1210,7 @@ public:
         new_species->c_part_max_                               = species->c_part_max_;
         new_species->mass_                                     = species->mass_;
         new_species->time_frozen_                              = species->time_frozen_;
+        new_species->push_every_                               = species->push_every_;
         new_species->radiating_                                = species->radiating_;
         new_species->relativistic_field_initialization_        = species->relativistic_field_initialization_;
         new_species->iter_relativistic_initialization_         = species->iter_relativistic_initialization_;
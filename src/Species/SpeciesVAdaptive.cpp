@@ -382,6 +382,11 @@ void SpeciesVAdaptive::reconfiguration( Params &params, Patch *patch )
             || ( vecto_time > scalar_time && this->vectorized_operators == true ) ) {
         reasign_operators = true;
     }
+
+    // Calibration phase of the cost model: both modes are alternately measured
+    if( params.adaptive_cost_model_calibration ) {
+        reasign_operators = true;
+    }
     // --------------------------------------------------------------------
 
     // Operator reasignment if required by the metrics
@@ -0,0 +1,141 @@
+#include <mpi.h>
+#include <iomanip>
+#include <algorithm>
+#include <limits>
+
+#include "Autotuner.h"
+
+#include "Params.h"
+#include "SmileiMPI.h"
+#include "TimeSelection.h"
+#include "Tools.h"
+
+using namespace std;
+
+Autotuner::Autotuner( Params &params, SmileiMPI *smpi ) :
+    window_( params.autotuning_window ),
+    retune_every_( params.autotuning_retune_every ),
+    exploring_( false ),
+    iknob_( 0 ),
+    icandidate_( 0 ),
+    phase_start_( -1 ),
+    phase_end_( -1 ),
+    phase_start_time_( 0. )
+{
+    if( ! params.has_autotuning ) {
+        return;
+    }
+    
+    for( unsigned int i=0; i<params.autotuning_parameters.size(); i++ ) {
+        Knob knob;
+        knob.name_ = params.autotuning_parameters[i];
+        if( knob.name_ == "load_balancing" ) {
+            knob.selection_ = params.load_balancing_time_selection;
+        } else {
+            knob.selection_ = params.adaptive_vecto_time_selection;
+        }
+        knob.best_ = max( 1, ( int )knob.selection_->getPeriod() );
+        knobs_.push_back( knob );
+    }
+    
+    if( smpi->isMaster() ) {
+        log_.open( "autotuning.txt" );
+        log_ << "# iteration parameter period time_per_iteration(s) decision" << endl;
+    }
+}
+
+Autotuner::~Autotuner()
+{
+    if( log_.is_open() ) {
+        log_.close();
+    }
+}
+
+void Autotuner::setCandidates( Knob &knob )
+{
+    knob.candidates_.resize( 0 );
+    knob.candidates_.push_back( knob.best_ );
+    if( knob.best_ > 1 ) {
+        knob.candidates_.push_back( knob.best_ / 2 );
+    }
+    knob.candidates_.push_back( knob.best_ * 2 );
+    knob.costs_.assign( knob.candidates_.size(), 0. );
+}
+
+void Autotuner::startPhase( int itime, unsigned int length )
+{
+    phase_start_ = itime;
+    phase_end_ = itime + length;
+    phase_start_time_ = MPI_Wtime();
+}
+
+void Autotuner::update( SmileiMPI *smpi, int itime )
+{
+    if( knobs_.empty() ) {
+        return;
+    }
+    
+    // First call: the first window is not measured (initial transient)
+    if( phase_start_ < 0 ) {
+        startPhase( itime, window_ );
+        return;
+    }
+    if( itime < phase_end_ ) {
+        return;
+    }
+    
+    // End of a phase
+    if( exploring_ ) {
+        // Time per iteration of the trial, of the slowest process
+        double cost = ( MPI_Wtime() - phase_start_time_ ) / ( double )( itime - phase_start_ );
+        MPI_Allreduce( MPI_IN_PLACE, &cost, 1, MPI_DOUBLE, MPI_MAX, smpi->world() );
+        
+        Knob &knob = knobs_[iknob_];
+        knob.costs_[icandidate_] = cost;
+        if( log_.is_open() ) {
+            log_ << itime << " " << knob.name_ << " " << knob.candidates_[icandidate_]
+                 << " " << scientific << setprecision( 4 ) << cost << " trial" << endl;
+        }
+        
+        // All candidates of this knob were tried: keep the best
+        if( ++icandidate_ == knob.candidates_.size() ) {
+            unsigned int ibest = min_element( knob.costs_.begin(), knob.costs_.end() ) - knob.costs_.begin();
+            if( knob.candidates_[ibest] != knob.best_ ) {
+                MESSAGE( 1, "Autotuning at iteration " << itime << ": " << knob.name_
+                         << " period " << knob.best_ << " -> " << knob.candidates_[ibest] );
+            }
+            knob.best_ = knob.candidates_[ibest];
+            knob.selection_->setPeriod( itime, knob.best_ );
+            if( log_.is_open() ) {
+                log_ << itime << " " << knob.name_ << " " << knob.best_
+                     << " " << scientific << setprecision( 4 ) << knob.costs_[ibest] << " selected" << endl;
+            }
+            
+            icandidate_ = 0;
+            // Next knob, or end of the exploration
+            if( ++iknob_ == knobs_.size() ) {
+                iknob_ = 0;
+                exploring_ = false;
+                startPhase( itime, retune_every_ );
+                // No retuning: the exploration is done once
+                if( retune_every_ == 0 ) {
+                    phase_end_ = numeric_limits<int>::max();
+                }
+                return;
+            }
+            setCandidates( knobs_[iknob_] );
+        }
+    } else {
+        // Start a new exploration
+        exploring_ = true;
+        iknob_ = 0;
+        icandidate_ = 0;
+        setCandidates( knobs_[0] );
+    }
+    
+    // Start the trial of the next candidate
+    Knob &knob = knobs_[iknob_];
+    int period = knob.candidates_[icandidate_];
+    knob.selection_->setPeriod( itime, period );
+    startPhase( itime, max( window_, 2 * ( unsigned int )period ) );
+}
@@ -0,0 +1,68 @@
+#ifndef AUTOTUNER_H
+#define AUTOTUNER_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+class Params;
+class SmileiMPI;
+class TimeSelection;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class Autotuner
+//! Tunes online the periods of the load balancing and of the adaptive vectorization reconfiguration.
+//! Every `retune_every` iterations, each parameter is successively set to half, once and twice its
+//! current best value during trial windows; the value giving the smallest wall time per iteration
+//! (maximum over MPI processes) is kept. All decisions are written in autotuning.txt.
+//  --------------------------------------------------------------------------------------------------------------------
+class Autotuner
+{
+public:
+    //! Constructor
+    Autotuner( Params &params, SmileiMPI *smpi );
+    //! Destructor
+    ~Autotuner();
+    
+    //! Account for the end of iteration `itime` (to be called outside of OpenMP parallel regions)
+    void update( SmileiMPI *smpi, int itime );
+    
+private:
+    
+    //! A tuned parameter: period of a time selection
+    struct Knob {
+        std::string name_;
+        TimeSelection *selection_;
+        //! Best period found so far
+        int best_;
+        //! Periods tried during the current exploration and their costs
+        std::vector<int> candidates_;
+        std::vector<double> costs_;
+    };
+    
+    //! Start a trial or an exploitation phase of `length` iterations after `itime`
+    void startPhase( int itime, unsigned int length );
+    //! Set the candidates of the knob around its best value
+    void setCandidates( Knob &knob );
+    
+    std::vector<Knob> knobs_;
+    
+    //! Number of iterations of each trial (at least twice the tried period)
+    unsigned int window_;
+    //! Number of iterations between two explorations (0: explore only once)
+    unsigned int retune_every_;
+    
+    //! True while trying candidates, false while using the best values
+    bool exploring_;
+    //! Knob and candidate of the current trial
+    unsigned int iknob_, icandidate_;
+    
+    //! First and last iterations of the current phase, and wall time at its beginning
+    int phase_start_, phase_end_;
+    double phase_start_time_;
+    
+    //! Log of the decisions (MPI master only)
+    std::ofstream log_;
+};
+
+#endif
@@ -0,0 +1,370 @@
+// ---------------------------------------------------------------------------------------------------------------------
+//! Main.cpp for the tool smilei_bench
+//! This tool times the particle operators (interpolator, pusher, projector,
+//! radiation and merging) of a single 3D patch filled with synthetic fields,
+//! without running a full simulation.
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <mpi.h>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <typeinfo>
+#include <cxxabi.h>
+#if defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#endif
+
+#include "Params.h"
+#include "SmileiMPI.h"
+#include "VectorPatch.h"
+#include "PatchesFactory.h"
+#include "RadiationTables.h"
+#include "PyTools.h"
+#include "Tools.h"
+
+//! Timing accumulated for one operator
+struct KernelTiming {
+    std::string name;
+    std::string class_name;
+    double seconds;
+    double cycles;
+    KernelTiming( std::string n, std::string c ) : name( n ), class_name( c ), seconds( 0. ), cycles( 0. ) {}
+};
+
+//! Time stamp counter (0 when not available on this processor)
+static inline unsigned long long readCycles()
+{
+#if defined( __x86_64__ ) || defined( __i386__ )
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+//! Readable name of the dynamic type of an operator
+template<typename T>
+static std::string className( T *op )
+{
+    if( !op ) {
+        return "none";
+    }
+    int status;
+    char *demangled = abi::__cxa_demangle( typeid( *op ).name(), 0, 0, &status );
+    std::string name = ( status==0 && demangled ) ? demangled : typeid( *op ).name();
+    free( demangled );
+    return name;
+}
+
+//! Copy all particle properties of src into dest (same species, same properties)
+static void restoreParticles( Particles &dest, Particles &src )
+{
+    for( unsigned int iprop=0 ; iprop<src.double_prop_.size() ; iprop++ ) {
+        *dest.double_prop_[iprop] = *src.double_prop_[iprop];
+    }
+    for( unsigned int iprop=0 ; iprop<src.short_prop_.size() ; iprop++ ) {
+        *dest.short_prop_[iprop] = *src.short_prop_[iprop];
+    }
+    for( unsigned int iprop=0 ; iprop<src.uint64_prop_.size() ; iprop++ ) {
+        *dest.uint64_prop_[iprop] = *src.uint64_prop_[iprop];
+    }
+}
+
+//! Fill a field with a smooth synthetic profile
+static void fillField( Field *field, double amplitude, double phase )
+{
+    if( !field ) {
+        return;
+    }
+    for( unsigned int i=0 ; i<field->globalDims_ ; i++ ) {
+        field->data_[i] = amplitude * sin( 0.01*i + phase );
+    }
+}
+
+int main( int argc, char *argv[] )
+{
+    // Benchmark parameters
+    unsigned int particles_per_cell = 64;
+    double temperature = 0.01;
+    unsigned int cluster_width = 4;
+    unsigned int cells = 16;
+    unsigned int order = 2;
+    unsigned int iterations = 20;
+    std::string vectorization = "off";
+    std::string pusher = "boris";
+    bool radiation = false;
+    bool merging = false;
+    std::string output = "smilei_bench.json";
+    std::vector<std::string> extra_namelist;
+
+    std::string help_message;
+    help_message =  "\n This tool times Smilei particle operators on one synthetic 3D patch.\n";
+    help_message += "\n";
+    help_message += " List of available options:\n";
+    help_message += " --ppc N                : particles per cell (default 64)\n";
+    help_message += " --temperature T        : electron temperature in units of mc^2 (default 0.01)\n";
+    help_message += " --cluster-width N      : cluster width (default 4)\n";
+    help_message += " --cells N              : number of cells of the patch in each direction (default 16)\n";
+    help_message += " --order 2|4            : interpolation and projection order (default 2)\n";
+    help_message += " --vectorization off|on : vectorization mode (default off)\n";
+    help_message += " --pusher NAME          : pusher of the species (default boris)\n";
+    help_message += " --radiation            : add the Monte-Carlo radiation operator\n";
+    help_message += " --merging              : add the Vranic cartesian merging operator (requires vectorization on)\n";
+    help_message += " --iterations N         : number of timed iterations (default 20)\n";
+    help_message += " --output FILE          : JSON output file (default smilei_bench.json)\n";
+    help_message += " --help                 : print this message\n";
+    help_message += " Any other argument is appended to the generated namelist.\n";
+
+    for( int iarg=1 ; iarg<argc ; iarg++ ) {
+        std::string arg = argv[iarg];
+        bool has_value = ( iarg+1<argc );
+        if( arg == "--help" || arg == "-h" ) {
+            std::cout << help_message << std::endl;
+            return 0;
+        } else if( arg == "--ppc" && has_value ) {
+            particles_per_cell = std::atoi( argv[++iarg] );
+        } else if( arg == "--temperature" && has_value ) {
+            temperature = std::atof( argv[++iarg] );
+        } else if( arg == "--cluster-width" && has_value ) {
+            cluster_width = std::atoi( argv[++iarg] );
+        } else if( arg == "--cells" && has_value ) {
+            cells = std::atoi( argv[++iarg] );
+        } else if( arg == "--order" && has_value ) {
+            order = std::atoi( argv[++iarg] );
+        } else if( arg == "--vectorization" && has_value ) {
+            vectorization = argv[++iarg];
+        } else if( arg == "--pusher" && has_value ) {
+            pusher = argv[++iarg];
+        } else if( arg == "--radiation" ) {
+            radiation = true;
+        } else if( arg == "--merging" ) {
+            merging = true;
+        } else if( arg == "--iterations" && has_value ) {
+            iterations = std::atoi( argv[++iarg] );
+        } else if( arg == "--output" && has_value ) {
+            output = argv[++iarg];
+        } else {
+            extra_namelist.push_back( arg );
+        }
+    }
+
+    // Namelist of a single periodic 3D patch with one thermal electron species
+    std::ostringstream namelist;
+    namelist << "dx = 0.5\n"
+             << "dt = 0.95 * dx / math.sqrt(3.)\n"
+             << "Main(\n"
+             << "    geometry = '3Dcartesian',\n"
+             << "    interpolation_order = " << order << ",\n"
+             << "    cell_length = [dx]*3,\n"
+             << "    grid_length = [" << cells << "*dx]*3,\n"
+             << "    number_of_patches = [1]*3,\n"
+             << "    timestep = dt,\n"
+             << "    simulation_time = " << iterations << "*dt,\n"
+             << "    EM_boundary_conditions = [['periodic']],\n"
+             << "    cluster_width = " << cluster_width << ",\n"
+             << "    reference_angular_frequency_SI = 2.*math.pi*3e8/1e-6,\n"
+             << "    print_every = 1000,\n"
+             << ")\n"
+             << "Vectorization( mode = '" << vectorization << "' )\n"
+             << "Species(\n"
+             << "    name = 'electron',\n"
+             << "    position_initialization = 'random',\n"
+             << "    momentum_initialization = 'maxwell-juttner',\n"
+             << "    particles_per_cell = " << particles_per_cell << ",\n"
+             << "    mass = 1.,\n"
+             << "    charge = -1.,\n"
+             << "    number_density = 1.,\n"
+             << "    temperature = [" << temperature << "]*3,\n"
+             << "    boundary_conditions = [['periodic']],\n"
+             << "    pusher = '" << pusher << "',\n"
+             << "    radiation_model = '" << ( radiation ? "Monte-Carlo" : "none" ) << "',\n"
+             << "    merging_method = '" << ( merging ? "vranic_cartesian" : "none" ) << "',\n"
+             << "    merge_every = 1,\n"
+             << ")\n";
+    std::vector<std::string> namelists( 1, "import math\n" + namelist.str() );
+    namelists.insert( namelists.end(), extra_namelist.begin(), extra_namelist.end() );
+
+    SmileiMPI smpi( &argc, &argv );
+
+    TITLE( "Reading the benchmark parameters" );
+    Params params( &smpi, namelists );
+    VectorPatch vecPatches( params );
+    smpi.init( params, vecPatches.domain_decomposition_ );
+
+    RadiationTables radiation_tables;
+    radiation_tables.initialization( params, &smpi );
+
+    TITLE( "Creating the synthetic patch" );
+    Patch *patch = PatchesFactory::create( params, &smpi, vecPatches.domain_decomposition_, 0 );
+    Species *species = patch->vecSpecies[0];
+    Particles *particles = species->particles;
+    ElectroMagn *EMfields = patch->EMfields;
+
+    fillField( EMfields->Ex_, 0.01, 0. );
+    fillField( EMfields->Ey_, 0.01, 1. );
+    fillField( EMfields->Ez_, 0.01, 2. );
+    fillField( EMfields->Bx_m, 0.01, 3. );
+    fillField( EMfields->By_m, 0.01, 4. );
+    fillField( EMfields->Bz_m, 0.01, 5. );
+
+    if( params.cell_sorting_ ) {
+        species->computeParticleCellKeys( params );
+        species->sortParticles( params, patch );
+    }
+
+    // Keep the initial state so that every iteration starts from the same particles
+    Particles reference;
+    reference.initialize( 0, *particles );
+    particles->copyParticles( 0, particles->size(), reference, 0 );
+
+    unsigned int npart = particles->size();
+    unsigned int nbin = particles->first_index.size();
+    unsigned int bytes_per_particle = 8*( particles->double_prop_.size() + particles->uint64_prop_.size() )
+                                    + 2*particles->short_prop_.size();
+
+    std::vector<KernelTiming> kernels;
+    kernels.push_back( KernelTiming( "interpolator", className( species->Interp ) ) );
+    kernels.push_back( KernelTiming( "pusher", className( species->Push ) ) );
+    kernels.push_back( KernelTiming( "projector", className( species->Proj ) ) );
+    if( species->Radiate ) {
+        kernels.push_back( KernelTiming( "radiation", className( species->Radiate ) ) );
+    }
+    if( species->Merge ) {
+        kernels.push_back( KernelTiming( "merging", className( species->Merge ) ) );
+    }
+
+    MESSAGE( 1, "Timing " << npart << " particles in " << nbin << " bins over " << iterations << " iterations" );
+
+    // The whole patch is processed as a single pack (vectorized operators)
+    // or bin by bin (scalar operators), as in the species dynamics
+    int ithread = 0;
+    double radiated_energy = 0.;
+    for( unsigned int it=0 ; it<iterations ; it++ ) {
+
+        restoreParticles( *particles, reference );
+        smpi.dynamics_resize( ithread, params.nDim_field, npart );
+
+        double t0;
+        unsigned long long c0;
+        unsigned int ikernel = 0;
+
+        // Interpolator
+        t0 = MPI_Wtime();
+        c0 = readCycles();
+        for( unsigned int ibin=0 ; ibin<nbin ; ibin++ ) {
+            if( params.cell_sorting_ ) {
+                species->Interp->fieldsWrapper( EMfields, *particles, &smpi, &( particles->first_index[ibin] ), &( particles->last_index[ibin] ), ithread, ibin, 0 );
+            } else {
+                species->Interp->fieldsWrapper( EMfields, *particles, &smpi, &( particles->first_index[ibin] ), &( particles->last_index[ibin] ), ithread );
+            }
+        }
+        kernels[ikernel].cycles += readCycles() - c0;
+        kernels[ikernel++].seconds += MPI_Wtime() - t0;
+
+        // Radiation is applied before the push, as in the species dynamics
+        double t_rad = 0., c_rad = 0.;
+        if( species->Radiate ) {
+            t0 = MPI_Wtime();
+            c0 = readCycles();
+            for( unsigned int ibin=0 ; ibin<nbin ; ibin++ ) {
+                ( *species->Radiate )( *particles, species->radiated_photons_, &smpi, radiation_tables, radiated_energy,
+                                       particles->first_index[ibin], particles->last_index[ibin], ithread );
+            }
+            c_rad = readCycles() - c0;
+            t_rad = MPI_Wtime() - t0;
+        }
+
+        // Pusher
+        t0 = MPI_Wtime();
+        c0 = readCycles();
+        if( params.cell_sorting_ ) {
+            ( *species->Push )( *particles, &smpi, 0, npart, ithread, 0 );
+        } else {
+            for( unsigned int ibin=0 ; ibin<nbin ; ibin++ ) {
+                ( *species->Push )( *particles, &smpi, particles->first_index[ibin], particles->last_index[ibin], ithread );
+            }
+        }
+        kernels[ikernel].cycles += readCycles() - c0;
+        kernels[ikernel++].seconds += MPI_Wtime() - t0;
+
+        // Projector (currents only)
+        t0 = MPI_Wtime();
+        c0 = readCycles();
+        for( unsigned int ibin=0 ; ibin<nbin ; ibin++ ) {
+            if( params.cell_sorting_ ) {
+                species->Proj->currentsAndDensityWrapper( EMfields, *particles, &smpi, particles->first_index[ibin], particles->last_index[ibin],
+                        ithread, false, params.is_spectral, 0, ibin, 0 );
+            } else {
+                species->Proj->currentsAndDensityWrapper( EMfields, *particles, &smpi, particles->first_index[ibin], particles->last_index[ibin],
+                        ithread, false, params.is_spectral, 0 );
+            }
+        }
+        kernels[ikernel].cycles += readCycles() - c0;
+        kernels[ikernel++].seconds += MPI_Wtime() - t0;
+
+        if( species->Radiate ) {
+            kernels[ikernel].cycles += c_rad;
+            kernels[ikernel++].seconds += t_rad;
+        }
+
+        // Merging works on the particles of each cell
+        if( species->Merge ) {
+            restoreParticles( *particles, reference );
+            std::vector<int> mask( npart, 1 );
+            std::vector<int> count( nbin );
+            for( unsigned int ibin=0 ; ibin<nbin ; ibin++ ) {
+                count[ibin] = particles->last_index[ibin] - particles->first_index[ibin];
+            }
+            t0 = MPI_Wtime();
+            c0 = readCycles();
+            for( unsigned int ibin=0 ; ibin<nbin ; ibin++ ) {
+                ( *species->Merge )( species->mass_, *particles, mask, &smpi, particles->first_index[ibin], particles->last_index[ibin], count[ibin] );
+            }
+            kernels[ikernel].cycles += readCycles() - c0;
+            kernels[ikernel++].seconds += MPI_Wtime() - t0;
+        }
+    }
+
+    // Report
+    TITLE( "Results" );
+    std::ofstream json( output.c_str() );
+    json << "{\n"
+         << "  \"config\": {\"particles_per_cell\": " << particles_per_cell
+         << ", \"temperature\": " << temperature
+         << ", \"cluster_width\": " << cluster_width
+         << ", \"cells\": " << cells
+         << ", \"order\": " << order
+         << ", \"vectorization\": \"" << vectorization << "\""
+         << ", \"iterations\": " << iterations
+         << ", \"particles\": " << npart
+         << ", \"bytes_per_particle\": " << bytes_per_particle
+         << ", \"version\": \"" << __VERSION << "\"},\n"
+         << "  \"kernels\": [\n";
+    for( unsigned int ikernel=0 ; ikernel<kernels.size() ; ikernel++ ) {
+        double processed = ( double )npart * iterations;
+        double particles_per_second = kernels[ikernel].seconds > 0. ? processed / kernels[ikernel].seconds : 0.;
+        double cycles_per_particle = kernels[ikernel].cycles / processed;
+        MESSAGE( 1, kernels[ikernel].name << " (" << kernels[ikernel].class_name << "): "
+                 << particles_per_second << " particles/s, " << cycles_per_particle << " cycles/particle" );
+        json << "    {\"kernel\": \"" << kernels[ikernel].name << "\""
+             << ", \"class\": \"" << kernels[ikernel].class_name << "\""
+             << ", \"seconds\": " << kernels[ikernel].seconds
+             << ", \"particles_per_second\": " << particles_per_second
+             << ", \"cycles_per_particle\": " << cycles_per_particle
+             << ", \"bytes_per_particle\": " << bytes_per_particle << "}"
+             << ( ikernel+1<kernels.size() ? "," : "" ) << "\n";
+    }
+    json << "  ]\n}\n";
+    json.close();
+    MESSAGE( 1, "Results written in " << output );
+
+    delete patch;
+    params.cleanup( &smpi );
+    PyTools::closePython();
+
+    return 0;
+}
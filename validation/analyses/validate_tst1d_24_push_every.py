@@ -0,0 +1,19 @@
+import os, re, numpy as np
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+
+
+Ex = S.Field.Field0.Ex(timesteps=320).getData()[0]
+Validate("Ex field at iteration 320", Ex, 0.001 )
+
+# Charge conservation with the sub-cycled push
+max_ubal = np.max( np.abs(S.Scalar.Ubal().getData()) )
+Validate("Max Ubal is below 2%", max_ubal<0.02 )
+
+# Sub-cycled ions follow the ions pushed at every iteration
+density     = np.array( S.ParticleBinning.Diag0(timesteps=320).getData()[0] )
+density_ref = np.array( S.ParticleBinning.Diag1(timesteps=320).getData()[0] )
+Validate("Sub-cycled density matches within 2%", np.max(np.abs(density-density_ref)) < 0.02*np.max(density_ref) )
+Validate("Density of the sub-cycled ions", density, 0.01 )
@@ -102,6 +102,7 @@ class ValidationOptions(object):
         self.max_time      = kwargs.pop( "max_time"     , "00:30:00"    )
         self.compile_mode  = kwargs.pop( "compile_mode" , ""            )
         self.log           = kwargs.pop( "log"          , ""            )
+        self.perf          = kwargs.pop( "perf"         , False         )
         self.partition     = kwargs.pop( "partition"    , "jollyjumper" )
         self.account       = kwargs.pop( "account"      , ""            )
         
@@ -116,6 +117,13 @@ class ValidationOptions(object):
         v.__dict__ = self.__dict__.copy()
         return v
 
+# Benchmarks run by default in performance mode
+PERF_BENCHMARKS = [
+    "tst3d_v_o2_thermal_plasma.py",
+    "tst2d_04_laser_wake.py",
+    "tst_collisions1_beam_relaxation.py",
+]
+
 def loadReference(references_path, bench_name):
     import pickle
     from sys import exit
@@ -329,6 +337,7 @@ class Validation(object):
         
         global _dataNotMatching
         _dataNotMatching = False
+        _slowerTimers = False
         for BENCH in self.list_benchmarks():
             SMILEI_BENCH = self.smilei_path.benchmarks + BENCH
             
@@ -390,6 +399,11 @@ class Validation(object):
                 log_dir = ("" if isabs(options.log) else INITIAL_DIRECTORY + sep) + options.log + sep
                 log = Log(log_dir, log_dir + BENCH + ".log")
             
+            # Prepare performance tracking: timers are stored next to the references
+            if options.perf:
+                perf_dir = self.smilei_path.references + "perf" + sep
+                perf_log = Log(perf_dir, perf_dir + BENCH + ".log")
+            
             # Loop restarts
             for irestart in range(options.nb_restarts+1):
                 
@@ -464,11 +478,37 @@ class Validation(object):
                 # Scan some info for logging
                 if options.log:
                     log.scan(self.smilei_path.output_file)
+                if options.perf:
+                    perf_log.scan(self.smilei_path.output_file)
             
             # Append info in log file
             if options.log:
                 log.append(self.git_version)
             
+            # In performance mode, store the timers or compare them to the stored ones
+            if options.perf:
+                if options.generate:
+                    if options.verbose:
+                        display.seperator()
+                        print( ' Storing timers of '+BENCH)
+                        display.seperator()
+                    perf_log.append(self.git_version)
+                else:
+                    if options.verbose:
+                        display.seperator()
+                        print( ' Comparing timers of '+BENCH)
+                        display.seperator()
+                    slower, untested = perf_log.compare()
+                    if untested:
+                        display.message("Not enough stored runs to test timers: "+", ".join(untested))
+                    for timer, value, mean, std, n in slower:
+                        display.error(" Timer "+timer+" of "+BENCH+" is slower: %g s vs. %g +/- %g s over %d runs"%(value, mean, std, n))
+                    if slower:
+                        _slowerTimers = True
+                chdir(self.smilei_path.workdirs)
+                rmtree(WORKDIR, True)
+                continue
+            
             # Find the validation script for this bench
             validation_script = self.smilei_path.analyses + "validate_" + BENCH
             if options.verbose:
@@ -521,6 +561,9 @@ class Validation(object):
         if _dataNotMatching:
             display.error( "Errors detected")
             exit(1)
+        elif _slowerTimers:
+            display.error( "Performance regressions detected")
+            exit(5)
         else:
             display.positive( "Everything passed")
     
@@ -531,7 +574,9 @@ class Validation(object):
         
         # Build the list of the requested input files
         list_validation = [basename(b) for b in glob(self.smilei_path.analyses+"validate_tst*py")]
-        if self.options.bench == "":
+        if self.options.bench == "" and self.options.perf:
+            benchmarks = PERF_BENCHMARKS
+        elif self.options.bench == "":
             benchmarks = [basename(b) for b in glob(self.smilei_path.benchmarks+"tst*py")]
         else:
             benchmarks = glob( self.smilei_path.benchmarks + self.options.bench )
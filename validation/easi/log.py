@@ -59,3 +59,33 @@ class Log:
             # Overwrite the file
             with open(self.log_file, 'w+') as f:
                 json.dump(db, f)
+
+    def compare(self, threshold=3., min_samples=3, min_relative=0.05, min_seconds=0.1):
+        """
+        Compare the current timers to those previously stored in the database.
+        A timer is flagged as slower when it exceeds the mean of the stored values
+        by more than `threshold` standard deviations, by more than `min_relative`
+        of the mean, and by more than `min_seconds`.
+        Returns a list of (timer, value, mean, std, nsamples) for flagged timers,
+        and the list of timers without enough stored values to be tested.
+        """
+        try:
+            with open(self.log_file, 'r') as f:
+                db = json.load(f)
+        except:
+            db = {}
+        slower = []
+        untested = []
+        for k,v in self.data.items():
+            if k in ["commit", "date"]:
+                continue
+            history = [h for h in db.get(k, []) if h is not None]
+            n = len(history)
+            if n < min_samples:
+                untested += [k]
+                continue
+            mean = sum(history) / n
+            std = (sum([(h-mean)**2 for h in history]) / (n-1))**0.5
+            if v > mean + threshold*std and v > mean*(1.+min_relative) and v > mean + min_seconds:
+                slower += [(k, v, mean, std, n)]
+        return slower, untested
@@ -1,10 +1,11 @@
 #!/usr/bin/env python
 
 """
-This script can do three things:
+This script can do four things:
   (1) generate validation reference(s) for given benchmark(s)
   (2) compare benchmark(s) to their reference(s)
   (3) show visually differences between benchmark(s) and their reference(s)
+  (4) track the performance of benchmark(s) (timers stored in `references/perf`)
 
 Usage
 #######
@@ -50,6 +51,9 @@ Loops through all requested benchmarks
         Executes the `validate_*` script and compares the result to the reference data
     If requested to show differences to previous references
         Executes the `validate_*` script and plots the result vs. the reference data
+    In performance mode (-P), the physics is not validated. Instead:
+        With -g, the timers printed by smilei are appended to `references/perf/<bench>.log`
+        Otherwise, each timer is compared to the stored ones and flagged if significantly slower
 
 Exit status:
 ============
@@ -58,6 +62,7 @@ Exit status:
 2  execution fails
 3  compilation fails
 4  bad option
+5  performance regression (performance mode only)
 
 Remark:
 =======
@@ -70,15 +75,15 @@ from getopt import getopt, GetoptError
 from easi import Validation
 
 def usage():
-    print( 'Usage: validation.py [-c] [-h] [-v] [-b <bench_case>] [-o <nb_OMPThreads>] [-m <nb_MPIProcs>] [-g | -s] [-r <nb_restarts>] [-t <max_time>] [-k <compile_mode>] [-p <partition name>] [-l <logs_folder>]' )
+    print( 'Usage: validation.py [-c] [-h] [-v] [-b <bench_case>] [-o <nb_OMPThreads>] [-m <nb_MPIProcs>] [-g | -s] [-r <nb_restarts>] [-t <max_time>] [-k <compile_mode>] [-p <partition name>] [-l <logs_folder>] [-P]' )
     print( '    Try `validation.py -h` for more details' )
 
 # Get command-line options
 try:
     external_options, remainder = getopt(
         argv[1:],
-        'o:m:b:r:k:p:gshvcl:t:a:n:',
-        ['OMP=', 'MPI=', 'BENCH=', 'RESTARTS=', 'PARTITION=', 'GENERATE', 'SHOW', 'HELP', 'VERBOSE', 'COMPILE_ONLY', 'COMPILE_MODE=', 'LOG=', 'time=', 'account=', 'nodes=', 'resource-file=']
+        'o:m:b:r:k:p:gshvcl:t:a:n:P',
+        ['OMP=', 'MPI=', 'BENCH=', 'RESTARTS=', 'PARTITION=', 'GENERATE', 'SHOW', 'HELP', 'VERBOSE', 'COMPILE_ONLY', 'COMPILE_MODE=', 'LOG=', 'time=', 'account=', 'nodes=', 'resource-file=', 'PERF']
     )
 except GetoptError as err:
     usage()
@@ -122,6 +127,8 @@ for opt, arg in external_options:
             exit(4)
     elif opt in ('-l', '--LOG'):
         options['log'] = arg
+    elif opt in ('-P', '--PERF'):
+        options['perf'] = True
     elif opt in ('-h', '--HELP'):
         print( """
 Options:
@@ -166,6 +173,12 @@ Options:
        <account id>: account/project id given by some super-computer facilities
   -l
        Log some performance info in the directory `logs`
+  -P
+       Performance mode: only the timers are checked (no physics validation).
+       DEFAULT benchmarks : tst3d_v_o2_thermal_plasma.py, tst2d_04_laser_wake.py, tst_collisions1_beam_relaxation.py
+       With -g, the timers are stored in `references/perf`.
+       Otherwise, a timer is flagged when it is slower than the stored runs
+       by more than 3 standard deviations, 5 % and 0.1 s (at least 3 stored runs needed).
 """)
         exit(0)
 